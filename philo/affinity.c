@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   affinity.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:32:00 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:51:16 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return The 'k'th CPU of 'set', counting from 0.
+ */
+static int	nth_cpu(const cpu_set_t *set, int k)
+{
+	int	cpu;
+
+	cpu = 0;
+	while (cpu < CPU_SETSIZE - 1 && (!CPU_ISSET(cpu, set) || k-- > 0))
+		cpu++;
+	return (cpu);
+}
+
+/**
+ * Pin the calling thread to 'cpu' with '-a' and make it SCHED_FIFO at
+ * 'priority' with '-F'. A refused SCHED_FIFO is reported once per run and
+ * the thread keeps the default policy.
+ *
+ * @param m Monitor of the run.
+ * @param cpu CPU to pin to.
+ * @param priority SCHED_FIFO priority.
+ */
+static void	pin_self(t_monitor *m, int cpu, int priority)
+{
+	cpu_set_t			set;
+	struct sched_param	param;
+	int					err;
+
+	if (m->opts.affinity != AFFINITY_NONE)
+	{
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+	if (m->opts.fifo == false)
+		return ;
+	param.sched_priority = priority;
+	err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+	if (err != 0 && atomic_exchange(&m->affinity.warned, true) == false)
+		fprintf(stderr, "warning: SCHED_FIFO refused (%s), using the "
+			"default policy\n", strerror(err));
+}
+
+/**
+ * Place the calling thread, thread 'idx' of 'count' running philosophers:
+ * a philosopher thread (in the children of 'procs' too) or a 'pool'
+ * worker, see set_affinity(). The first CPU the run may use is left to
+ * the monitor when there are at least two. 'rr' gives thread 'idx' CPU
+ * 'idx' modulo the rest; 'block' gives each CPU a run of consecutive
+ * threads, so most neighbours sharing a fork share a core and its cache,
+ * and neighbouring runs land on CPUs numbered together, which is usually
+ * the same NUMA node.
+ *
+ * @param m Monitor of the run.
+ * @param idx Zero-based index of the thread, a philosopher's is 'id' - 1.
+ * @param count Threads placed this way.
+ */
+void	affinity_place(t_monitor *m, int idx, int count)
+{
+	const int			reserved = (m->affinity.count > 1);
+	const int			cpus = m->affinity.count - reserved;
+	int					k;
+
+	if (m->opts.affinity == AFFINITY_NONE && m->opts.fifo == false)
+		return ;
+	k = idx % cpus;
+	if (m->opts.affinity == AFFINITY_BLOCK)
+		k = (int64_t)idx * cpus / count;
+	pin_self(m, nth_cpu(&m->affinity.allowed, reserved + k),
+		sched_get_priority_min(SCHED_FIFO));
+}
+
+/**
+ * '-F': give the log writer and the timer service the philosophers'
+ * priority. Left behind at the default policy, they would only run when no
+ * philosopher is runnable, and philosophers block on a full log.
+ */
+static void	promote_helpers(t_monitor *m)
+{
+	struct sched_param	param;
+
+	param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+	if (m->log.started)
+		pthread_setschedparam(m->log.thread, SCHED_FIFO, &param);
+	if (m->timers.started)
+		pthread_setschedparam(m->timers.thread, SCHED_FIFO, &param);
+}
+
+/**
+ * Place a monitor shard: shard 0, the thread running the simulation, on
+ * the first CPU the run may use and the others one CPU after another, all
+ * above the philosophers with '-F'. Shard 0 is placed once the engine has
+ * created its threads, so none of them inherits the placement.
+ *
+ * @param m Monitor, called from the shard's own thread.
+ * @param shard Index of the shard, see loop_monitor().
+ */
+void	affinity_monitor(t_monitor *m, int shard)
+{
+	if (m->opts.affinity == AFFINITY_NONE && m->opts.fifo == false)
+		return ;
+	pin_self(m, nth_cpu(&m->affinity.allowed, shard % m->affinity.count),
+		sched_get_priority_min(SCHED_FIFO) + 1);
+	if (m->opts.fifo && shard == 0)
+		promote_helpers(m);
+}
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   affinity_save.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:32:00 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 05:32:00 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Remember the CPUs and the scheduling policy of the thread starting the
+ * run, before any thread is created: the placement is computed from those
+ * CPUs and affinity_restore() gives them back.
+ *
+ * @param m Monitor, called from its own thread.
+ */
+void	affinity_save(t_monitor *m)
+{
+	t_affinity *const	a = &m->affinity;
+
+	if (m->opts.affinity == AFFINITY_NONE && m->opts.fifo == false)
+		return ;
+	pthread_getaffinity_np(pthread_self(), sizeof(a->allowed), &a->allowed);
+	a->count = CPU_COUNT(&a->allowed);
+	pthread_getschedparam(pthread_self(), &a->policy, &a->param);
+	a->saved = true;
+}
+
+/**
+ * Give the thread that ran the monitor back the CPUs and the scheduling
+ * policy affinity_save() found, so an embedding program gets its thread
+ * back as it was.
+ *
+ * @param m Monitor, called from its own thread.
+ */
+void	affinity_restore(t_monitor *m)
+{
+	t_affinity *const	a = &m->affinity;
+
+	if (a->saved == false)
+		return ;
+	pthread_setaffinity_np(pthread_self(), sizeof(a->allowed), &a->allowed);
+	pthread_setschedparam(pthread_self(), a->policy, &a->param);
+	a->saved = false;
+}
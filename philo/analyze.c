@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   analyze.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:02:22 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "analyze.h"
+
+/**
+ * Without a death, a run that ended must have fed every philosopher its
+ * own 'must_eat' times.
+ *
+ * @param a Analysis that has replayed every record.
+ */
+static void	check_end(t_analysis *a)
+{
+	int	i;
+
+	if (a->death_time != -1)
+		return ;
+	i = 0;
+	while (i < a->header->philos)
+	{
+		if (a->rules[i].must_eat != INT_MAX
+			&& a->seats[i].meals < a->rules[i].must_eat)
+			check_report(a, NULL, i + 1, "ate fewer than must_eat meals");
+		i++;
+	}
+}
+
+/**
+ * Map 'path' read-only and check that it holds a trace this build can read:
+ * the right magic, version and record size, then a valid topology and a
+ * whole number of records, see check_layout().
+ *
+ * @param a Analysis to point at the mapped header and records.
+ * @return 0 on success, -1 with an error printed otherwise.
+ */
+static int	map_trace(t_analysis *a, const char *path)
+{
+	struct stat	st;
+	void		*map;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd == -1 || fstat(fd, &st) == -1
+		|| st.st_size < (off_t) sizeof(t_trace_header))
+		map = MAP_FAILED;
+	else
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (fd != -1)
+		close(fd);
+	a->header = map;
+	if (map == MAP_FAILED || a->header->magic != TRACE_MAGIC
+		|| a->header->version != TRACE_VERSION
+		|| a->header->record_size != sizeof(t_event)
+		|| check_layout(a, st.st_size) == -1)
+	{
+		printf("error: %s is not a philo trace\n", path);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * '-p': print the trace as the text philo writes without '-t', formatted
+ * with the same log_format_event() and flushed in large writes.
+ */
+static void	print_text(const t_analysis *a)
+{
+	char	buf[LOG_BUFFER_SIZE];
+	int64_t	i;
+	int		len;
+
+	len = 0;
+	i = 0;
+	while (i < a->count)
+	{
+		if (len > LOG_BUFFER_SIZE - 64)
+		{
+			write(STDOUT_FILENO, buf, len);
+			len = 0;
+		}
+		len += log_format_event(buf + len, &a->events[i++]);
+	}
+	write(STDOUT_FILENO, buf, len);
+}
+
+/**
+ * Replay every record of the trace against the rules and print a verdict
+ * to stderr.
+ *
+ * @return 0 if the trace follows every rule, 1 otherwise.
+ */
+static int	analyze(t_analysis *a)
+{
+	int64_t	i;
+
+	a->seats = calloc(a->header->philos, sizeof(t_seat));
+	a->busy_until = calloc(a->header->resources + 1, sizeof(int64_t));
+	a->busy_by = calloc(a->header->resources + 1, sizeof(int));
+	if (a->seats == NULL || a->busy_until == NULL || a->busy_by == NULL)
+		return (1);
+	a->death_time = -1;
+	i = 0;
+	while (i < a->count)
+		check_event(a, &a->events[i++]);
+	check_end(a);
+	free(a->seats);
+	free(a->busy_until);
+	free(a->busy_by);
+	if (a->errors > 0)
+	{
+		fprintf(stderr, "KO: %ld violations in %ld records\n",
+			(long)a->errors, (long)a->count);
+		return (1);
+	}
+	fprintf(stderr, "OK: %ld records, %d philos\n", (long)a->count,
+		a->header->philos);
+	return (0);
+}
+
+/**
+ * philo_analyze [-p] <trace>: check a trace written by 'philo -t' against
+ * the rules of the simulation, and with '-p' print it as text on stdout.
+ *
+ * @return 0 if the trace is valid, 1 if it breaks a rule, 2 on bad usage.
+ */
+int	main(int ac, char **av)
+{
+	t_analysis	a;
+	bool		print;
+
+	memset(&a, 0, sizeof(a));
+	print = (ac == 3 && strcmp(av[1], "-p") == 0);
+	if (ac != 2 + print)
+	{
+		printf("usage: philo_analyze [-p] <trace>\n");
+		return (2);
+	}
+	if (map_trace(&a, av[1 + print]) == -1)
+		return (2);
+	if (print)
+		print_text(&a);
+	return (analyze(&a));
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   analyze.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:02:22 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ANALYZE_H
+# define ANALYZE_H
+
+# include "philo.h"
+# include <sys/mman.h>	//	- mmap()
+# include <sys/stat.h>	//	- fstat()
+
+# define DEATH_TOLERANCE 10000			// (microseconds)
+# define ERRORS_SHOWN 10				// violations printed before counting
+
+typedef struct s_seat		t_seat;
+typedef struct s_analysis	t_analysis;
+
+/**
+ * What philo_analyze remembers about one philosopher while replaying.
+ */
+struct s_seat
+{
+	int64_t				last_ate;			// last 'is eating', 0 is the start
+	int					meals;
+	int					forks;				// taken since it last slept
+};
+
+/**
+ * A mapped trace and the state of the replay checking it.
+ */
+struct s_analysis
+{
+	const t_trace_header	*header;
+	const int32_t		*offsets;			// topology rows, after the header
+	const int32_t		*needs;				// resources of the rows
+	const t_trace_rules	*rules;				// per philosopher, after them
+	const t_event		*events;			// after the rules
+	int64_t				count;				// records in the trace
+	t_seat				*seats;				// indexed by id - 1
+	int64_t				*busy_until;		// per resource, last meal's end
+	int					*busy_by;			// per resource, who ate with it
+	int64_t				last_time;			// time of the previous record
+	int64_t				death_time;			// -1 until someone died
+	int64_t				errors;				// rule violations found
+};
+
+// analyze_layout.c
+int		check_layout(t_analysis *a, int64_t size);
+
+// analyze_check.c
+void	check_report(t_analysis *a, const t_event *e, int id,
+			const char *what);
+void	check_event(t_analysis *a, const t_event *e);
+
+#endif
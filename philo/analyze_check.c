@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   analyze_check.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:02:22 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "analyze.h"
+
+/**
+ * Report one rule violation. Only the first 'ERRORS_SHOWN' are printed,
+ * the rest are just counted.
+ *
+ * @param e Record that broke the rule, NULL for the end of the trace.
+ * @param id Philosopher concerned.
+ * @param what Which rule was broken.
+ */
+void	check_report(t_analysis *a, const t_event *e, int id,
+		const char *what)
+{
+	if (a->errors++ >= ERRORS_SHOWN)
+		return ;
+	if (e == NULL)
+		fprintf(stderr, "end of trace, philo %d: %s\n", id, what);
+	else
+		fprintf(stderr, "%ld us, philo %d: %s\n", (long)e->time, id, what);
+}
+
+/**
+ * A meal needs every fork of the philosopher's row, none of them may still
+ * be in use for a meal that started less than the eater's shortest meal
+ * before, and it must start before the philosopher was due to die.
+ */
+static void	check_meal(t_analysis *a, const t_event *e, t_seat *s)
+{
+	const int	idx = e->id - 1;
+	int			shared;
+	int			i;
+
+	if (s->forks != a->offsets[idx + 1] - a->offsets[idx])
+		check_report(a, e, e->id, "eats without holding all its forks");
+	shared = 0;
+	i = a->offsets[idx];
+	while (i < a->offsets[idx + 1])
+	{
+		shared |= (a->busy_by[a->needs[i]] != idx
+				&& e->time < a->busy_until[a->needs[i]]);
+		a->busy_by[a->needs[i]] = idx;
+		a->busy_until[a->needs[i++]] = e->time + a->rules[idx].shortest_meal;
+	}
+	if (shared)
+		check_report(a, e, e->id, "eats with a neighbour's fork");
+	if (e->time - s->last_ate > a->rules[idx].time_to_die)
+		check_report(a, e, e->id, "eats after it should have died");
+	s->last_ate = e->time;
+	s->meals++;
+}
+
+/**
+ * A death is printed no earlier than 'time_to_die' after the last meal and
+ * no later than 'DEATH_TOLERANCE' after that.
+ */
+static void	check_death(t_analysis *a, const t_event *e, const t_seat *s)
+{
+	const int64_t	die = a->rules[e->id - 1].time_to_die;
+
+	a->death_time = e->time;
+	if (e->time - s->last_ate < die)
+		check_report(a, e, e->id, "dies before time_to_die");
+	if (e->time - s->last_ate > die + DEATH_TOLERANCE)
+		check_report(a, e, e->id, "death is printed more than 10 ms late");
+}
+
+/**
+ * Replay one record against the rules: records are in time order, nothing
+ * follows a death, no more forks are held than the philosopher eats with,
+ * meals are checked by check_meal() and deaths by check_death().
+ *
+ * @param a Analysis in progress.
+ * @param e Next record of the trace.
+ */
+void	check_event(t_analysis *a, const t_event *e)
+{
+	t_seat	*s;
+
+	if (e->id < 1 || e->id > a->header->philos || e->state < TOOK_FORK
+		|| e->state > DEAD)
+	{
+		check_report(a, e, e->id, "is not a valid record");
+		return ;
+	}
+	if (e->time < a->last_time)
+		check_report(a, e, e->id, "is logged out of order");
+	if (a->death_time != -1)
+		check_report(a, e, e->id, "is logged after a death");
+	a->last_time = e->time;
+	s = &a->seats[e->id - 1];
+	if (e->state == TOOK_FORK && ++s->forks
+		> a->offsets[e->id] - a->offsets[e->id - 1])
+		check_report(a, e, e->id, "holds more forks than it eats with");
+	else if (e->state == EATING)
+		check_meal(a, e, s);
+	else if (e->state == SLEEPING)
+		s->forks = 0;
+	else if (e->state == DEAD)
+		check_death(a, e, s);
+}
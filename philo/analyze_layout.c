@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   analyze_layout.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:41:51 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:41:51 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "analyze.h"
+
+/**
+ * Check that the rows of the topology name resources of the table, and
+ * that every philosopher's rules could have been run.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+static int	check_rows(const t_analysis *a)
+{
+	const t_trace_header *const	h = a->header;
+	int64_t						i;
+
+	i = 0;
+	while (i < h->philos && a->offsets[i] <= a->offsets[i + 1])
+		i++;
+	if (i < h->philos || a->offsets[0] != 0 || a->offsets[i] != h->needs)
+		return (-1);
+	i = 0;
+	while (i < h->needs && a->needs[i] >= 0 && a->needs[i] < h->resources)
+		i++;
+	if (i < h->needs)
+		return (-1);
+	i = 0;
+	while (i < h->philos && a->rules[i].time_to_die > 0
+		&& a->rules[i].shortest_meal >= 0 && a->rules[i].must_eat > 0)
+		i++;
+	if (i < h->philos)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Find the topology after the header, the philosophers' rules after it and
+ * the records after them, see 't_trace_header', and check them with
+ * check_rows().
+ *
+ * @param size Size of the mapped trace in bytes.
+ * @return 0 on success, -1 if the trace is not laid out as 't_trace_header'
+ * says.
+ */
+int	check_layout(t_analysis *a, int64_t size)
+{
+	const t_trace_header *const	h = a->header;
+	int64_t						rules;
+	int64_t						start;
+
+	rules = ((int64_t)h->philos + 1 + h->needs) * sizeof(int32_t);
+	rules += rules % 8 + sizeof(*h);
+	start = rules + (int64_t)h->philos * sizeof(t_trace_rules);
+	if (h->philos < 1 || h->needs < 0 || h->resources < 0 || size < start
+		|| (size - start) % sizeof(t_event) != 0)
+		return (-1);
+	a->offsets = (const int32_t *)(h + 1);
+	a->needs = a->offsets + h->philos + 1;
+	a->rules = (const t_trace_rules *)((const char *)h + rules);
+	a->events = (const t_event *)((const char *)h + start);
+	a->count = (size - start) / sizeof(t_event);
+	return (check_rows(a));
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   api.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:12:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 06:24:26 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Allocate a simulation with the default options and no arguments yet,
+ * see philo_sim_configure() and philo_sim_parse().
+ *
+ * @return The simulation, NULL on allocation failure.
+ */
+t_philo_sim	*philo_sim_create(void)
+{
+	t_monitor	*m;
+
+	m = aligned_alloc(CACHE_LINE, sizeof(t_monitor));
+	if (m == NULL)
+		return (NULL);
+	memset(m, 0, sizeof(*m));
+	options_defaults(&m->opts);
+	m->created_at = current_time();
+	return (m);
+}
+
+/**
+ * Receive every event on 'fn' instead of the text on stdout (or the '-t'
+ * trace). 'fn' is called from the log's writer thread, in order and in
+ * batches, so it must not block for long: producers wait once the ring is
+ * full. Set it before philo_sim_run().
+ *
+ * @param sim Simulation to observe.
+ * @param fn Callback, or NULL to go back to the default output.
+ * @param ctx Passed to every call of 'fn'.
+ */
+void	philo_sim_on_event(t_philo_sim *sim, t_philo_event_fn fn, void *ctx)
+{
+	sim->log.sink = fn;
+	sim->log.sink_ctx = ctx;
+}
+
+/**
+ * Run the configured simulation to its end in the calling thread, see
+ * run_simulation(), or with '-b' every simulation of the batch, see
+ * batch_run(). A simulation runs once.
+ *
+ * @param sim Configured simulation.
+ * @return 0 once the run is over, -1 if it was not configured or could not
+ * be started.
+ */
+int	philo_sim_run(t_philo_sim *sim)
+{
+	if (sim->opts.batch_file != NULL)
+		return (batch_run(&sim->opts));
+	if (sim->args[0] <= 0 || sim->philos != NULL)
+		return (-1);
+	return (run_simulation(sim, sim->args));
+}
+
+/**
+ * Ask a running simulation to stop, from any thread, including the event
+ * callback. The monitor notices within 'MONITOR_MAX_SLEEP' and
+ * philo_sim_run() returns once every philosopher has been stopped.
+ *
+ * @param sim Simulation to stop.
+ */
+void	philo_sim_stop(t_philo_sim *sim)
+{
+	if (set_stop_simulation(sim))
+		stop_broadcast(sim);
+}
+
+/**
+ * Release a simulation that is not running.
+ *
+ * @param sim Simulation from philo_sim_create(), or NULL.
+ */
+void	philo_sim_destroy(t_philo_sim *sim)
+{
+	if (sim == NULL)
+		return ;
+	run_free(sim);
+	free(sim);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   api_config.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:12:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Validate and parse command-line arguments into the 'args' array:
+ *  args[0] = number_of_philosophers
+ *  args[1] = time_to_die (ms)
+ *  args[2] = time_to_eat (ms)
+ *  args[3] = time_to_sleep (ms)
+ *  args[4] = optional must_eat count or INT_MAX when omitted.
+ * Argument values less than or equal to 0 are invalid.
+ *
+ * @param args Output array of five integers.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int	parse_args(int ac, char **av, int args[5])
+{
+	if (ac < 5 || ac > 6)
+		return (-1);
+	args[0] = parse_nbr(av[1]);
+	args[1] = parse_nbr(av[2]);
+	args[2] = parse_nbr(av[3]);
+	args[3] = parse_nbr(av[4]);
+	if (args[0] <= 0 || args[1] <= 0 || args[2] <= 0 || args[3] <= 0)
+		return (-1);
+	if (ac == 6)
+	{
+		args[4] = parse_nbr(av[5]);
+		if (args[4] <= 0)
+			return (-1);
+	}
+	else
+		args[4] = INT_MAX;
+	return (0);
+}
+
+/**
+ * Configure 'sim' from a command line, as the philo program takes it:
+ * options (see parse_options()) followed by the positional arguments, which
+ * '-b' replaces.
+ *
+ * @param sim Simulation that has not run yet.
+ * @return 0 on success, -1 on invalid options or arguments.
+ */
+int	philo_sim_parse(t_philo_sim *sim, int ac, char **av)
+{
+	int	first;
+
+	first = parse_options(ac, av, &sim->opts);
+	if (first != -1 && sim->opts.batch_file != NULL && first == ac)
+		return (0);
+	if (first == -1 || sim->opts.batch_file != NULL
+		|| parse_args(ac - first + 1, av + first - 1, sim->args) == -1)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Options of 'c' on top of the defaults, see options_defaults().
+ *
+ * @return 0 on success, -1 on an unknown engine or strategy.
+ */
+static int	config_options(t_options *opts, const t_philo_config *c)
+{
+	options_defaults(opts);
+	if (c->engine != NULL)
+		opts->engine = engine_find(c->engine);
+	if (c->strategy != NULL)
+		opts->strategy = strategy_find(c->strategy);
+	if (c->workers > 0)
+		opts->workers = c->workers;
+	opts->seed = c->seed;
+	opts->wheel = c->wheel;
+	opts->topology = c->topology;
+	opts->profile = c->profile;
+	if (opts->engine == NULL || opts->strategy == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Configure 'sim' from 'c', with the same rules as the command line: every
+ * count and time must be positive, 'must_eat' may be 0 for no limit.
+ *
+ * @param sim Simulation that has not run yet.
+ * @param c Configuration to copy.
+ * @return 0 on success, -1 on an invalid configuration.
+ */
+int	philo_sim_configure(t_philo_sim *sim, const t_philo_config *c)
+{
+	if (c->philos <= 0 || c->time_to_die <= 0 || c->time_to_eat <= 0
+		|| c->time_to_sleep <= 0 || c->must_eat < 0
+		|| config_options(&sim->opts, c) == -1)
+		return (-1);
+	sim->args[0] = c->philos;
+	sim->args[1] = c->time_to_die;
+	sim->args[2] = c->time_to_eat;
+	sim->args[3] = c->time_to_sleep;
+	sim->args[4] = c->must_eat;
+	if (c->must_eat == 0)
+		sim->args[4] = INT_MAX;
+	return (0);
+}
@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   api_results.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:12:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:09:09 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Fill 'out' with the figures of a finished run: see report_collect() for
+ * the meal and wait counters and report_print() for what they mean. All
+ * zero if the run never started.
+ *
+ * @param sim Simulation after philo_sim_run() returned.
+ * @param out Results to fill.
+ */
+void	philo_sim_results(t_philo_sim *sim, t_philo_results *out)
+{
+	const int64_t	start_time = atomic_load(&sim->start_time);
+	t_summary		s;
+
+	memset(out, 0, sizeof(*out));
+	if (start_time == 0)
+		return ;
+	report_collect(sim, &s);
+	out->elapsed = sim->end_time - start_time;
+	out->meals = s.meals;
+	out->meals_min = s.min_meals;
+	out->meals_max = s.max_meals;
+	out->fairness = 1.0;
+	if (s.meals_squared > 0)
+		out->fairness = (double)s.meals * s.meals
+			/ (sim->total_philos * s.meals_squared);
+	out->total_wait = s.total_wait;
+	out->max_wait = s.max_wait;
+	out->max_hunger = s.max_hunger;
+	out->died = sim->log.death.id;
+	out->death_time = sim->log.death.time;
+	out->detect_latency = sim->detect_latency;
+	out->stop_latency = sim->stop_latency;
+	if (sim->created_at != 0 && sim->opts.engine->virtual_clock == false)
+		out->startup = start_time - sim->created_at;
+}
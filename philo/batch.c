@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:25:24 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:51:54 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Wait until 'cost' more threads fit in the budget, or until nothing else
+ * runs, and take them. A negative 'cost' gives threads back.
+ *
+ * @param b Batch in progress.
+ * @param cost Threads of the run to admit, or minus those of a finished run.
+ */
+void	batch_admit(t_batch *b, int cost)
+{
+	pthread_mutex_lock(&b->mutex);
+	while (cost > 0 && b->in_use > 0 && b->in_use + cost > b->budget)
+		pthread_cond_wait(&b->freed, &b->mutex);
+	b->in_use += cost;
+	if (cost < 0)
+		pthread_cond_broadcast(&b->freed);
+	pthread_mutex_unlock(&b->mutex);
+}
+
+/**
+ * Options of every run: those of the command line, without the outputs
+ * ('-r', '-H', '-J', '-t', '-L') that would collide between concurrent runs.
+ * The thread budget is the CPUs the process may run on, as affinity_save()
+ * counts them, so 'taskset' and cpusets are honoured.
+ */
+static void	batch_init(t_batch *b, const t_options *opts)
+{
+	cpu_set_t	allowed;
+
+	memset(b, 0, sizeof(*b));
+	b->file = opts->batch_file;
+	b->opts = *opts;
+	b->opts.report = false;
+	b->opts.stats = false;
+	b->opts.histograms = false;
+	b->opts.stats_file = NULL;
+	b->opts.trace_file = NULL;
+	b->opts.live_file = NULL;
+	b->opts.batch_file = NULL;
+	b->budget = sysconf(_SC_NPROCESSORS_ONLN);
+	if (pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) == 0)
+		b->budget = CPU_COUNT(&allowed);
+	pthread_mutex_init(&b->mutex, NULL);
+	pthread_cond_init(&b->freed, NULL);
+}
+
+/**
+ * Join every run, which uses the batch to its end, and release the batch.
+ *
+ * @return 0, -1 if a line was invalid or a run failed.
+ */
+static int	batch_end(t_batch *b)
+{
+	while (b->spawned > 0)
+		pthread_join(b->threads[--b->spawned], NULL);
+	free(b->threads);
+	pthread_mutex_destroy(&b->mutex);
+	pthread_cond_destroy(&b->freed);
+	return (-atomic_load(&b->failed));
+}
+
+/**
+ * '-b': run every configuration of the batch file, one per line as the
+ * positional arguments of the program, concurrently as the CPUs allow (see
+ * batch_admit()). Each run logs to '<file>.<line>.log' and prints a summary
+ * line on stdout when it ends, see batch_init() for the options. Every run
+ * is joined before the batch is gone, see batch_end(). '-a' and '-F' are
+ * refused: every run would place its threads on the same CPUs.
+ *
+ * @param opts Options of every run, with 'batch_file' set.
+ * @return 0 once every run is over, -1 if a line was invalid or a run failed.
+ */
+int	batch_run(const t_options *opts)
+{
+	t_batch		b;
+	FILE		*file;
+	char		*line;
+	size_t		size;
+
+	if (opts->affinity != AFFINITY_NONE || opts->fifo)
+	{
+		fprintf(stderr, "error: '-a' and '-F' cannot be used with '-b'\n");
+		return (-1);
+	}
+	file = fopen(opts->batch_file, "r");
+	if (file == NULL)
+	{
+		perror(opts->batch_file);
+		return (-1);
+	}
+	batch_init(&b, opts);
+	line = NULL;
+	size = 0;
+	while (getline(&line, &size, file) != -1)
+		batch_start(&b, line);
+	free(line);
+	fclose(file);
+	return (batch_end(&b));
+}
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_file.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:25:24 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 05:25:24 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Cut 'line' into its whitespace-separated fields, in place. A '#' starts
+ * a comment that runs to the end of the line.
+ *
+ * @param fields Output, the fields follow a program name in fields[0].
+ * @return Number of fields including fields[0], -1 if there are too many.
+ */
+static int	split_fields(char *line, char *fields[7])
+{
+	int	count;
+
+	count = 1;
+	while (*line != '\0' && *line != '#')
+	{
+		if (*line == ' ' || *line == '\t' || *line == '\n')
+			*line++ = '\0';
+		else if (count == 7)
+			return (-1);
+		else
+		{
+			fields[count++] = line;
+			while (*line != '\0' && *line != ' ' && *line != '\t'
+				&& *line != '\n' && *line != '#')
+				line++;
+		}
+	}
+	*line = '\0';
+	return (count);
+}
+
+/**
+ * Parse one line of a batch file: the positional arguments of the philo
+ * program, "philos time_to_die time_to_eat time_to_sleep [must_eat]".
+ * Blank lines and comments are skipped.
+ *
+ * @param line Line read from the file, modified.
+ * @param args Output, see parse_args().
+ * @return 1 for a configuration, 0 for nothing to run, -1 if invalid.
+ */
+int	batch_parse_line(char *line, int args[5])
+{
+	char	*fields[7];
+	int		count;
+
+	fields[0] = "batch";
+	count = split_fields(line, fields);
+	if (count == 1)
+		return (0);
+	if (count == -1 || parse_args(count, fields, args) == -1)
+		return (-1);
+	return (1);
+}
+
+/**
+ * Event callback of a batch run: the same text the philo program prints,
+ * buffered by stdio in the run's own log file.
+ */
+static void	batch_log_event(void *ctx, const t_philo_event *event)
+{
+	t_batch_run *const	r = ctx;
+	char				buf[64];
+	int					len;
+
+	len = log_format_event(buf, event);
+	fwrite(buf, 1, len, r->log);
+}
+
+/**
+ * Prepare the run of the configuration on the batch file's current line,
+ * with the options of the batch, and open its log.
+ *
+ * @param b Batch the run belongs to.
+ * @param args Configuration from batch_parse_line().
+ * @return The run, NULL on failure.
+ */
+t_batch_run	*batch_new_run(t_batch *b, int args[5])
+{
+	t_batch_run	*r;
+
+	r = calloc(1, sizeof(*r));
+	if (r == NULL)
+		return (NULL);
+	r->batch = b;
+	r->line = b->line;
+	r->sim = philo_sim_create();
+	if (r->sim == NULL || snprintf(r->path, sizeof(r->path), "%s.%d.log",
+			b->file, r->line) >= (int)sizeof(r->path))
+		r->log = NULL;
+	else
+		r->log = fopen(r->path, "w");
+	if (r->log == NULL)
+	{
+		batch_free_run(r);
+		return (NULL);
+	}
+	r->sim->opts = b->opts;
+	memcpy(r->sim->args, args, sizeof(r->sim->args));
+	philo_sim_on_event(r->sim, batch_log_event, r);
+	return (r);
+}
+
+/**
+ * Close the log and release the simulation of a run.
+ *
+ * @param r Run from batch_new_run().
+ */
+void	batch_free_run(t_batch_run *r)
+{
+	if (r->log != NULL)
+		fclose(r->log);
+	philo_sim_destroy(r->sim);
+	free(r);
+}
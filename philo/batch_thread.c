@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_thread.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:26:13 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:51:54 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Threads a run keeps busy: 'threads' has one per philosopher, 'pool' its
+ * workers and the timer service, 'des' only the simulation; all of them
+ * also have the monitor (or simulation) thread and the log writer.
+ */
+static int	run_cost(const t_options *opts, int philos)
+{
+	if (strcmp(opts->engine->name, "des") == 0)
+		return (2);
+	if (strcmp(opts->engine->name, "pool") == 0)
+		return (opts->workers + 3);
+	return (philos + 2 + opts->wheel);
+}
+
+/**
+ * Thread of one run: simulate, print its summary line on stdout and give
+ * its threads back to the batch.
+ *
+ * @param arg The run, released here.
+ * @return NULL.
+ */
+static void	*run_main(void *arg)
+{
+	t_batch_run *const	r = arg;
+	t_batch *const		b = r->batch;
+	const int			cost = r->cost;
+	t_philo_results		res;
+
+	if (philo_sim_run(r->sim) == -1)
+	{
+		fprintf(stderr, "%s:%d: run failed\n", b->file, r->line);
+		atomic_store(&b->failed, true);
+	}
+	philo_sim_results(r->sim, &res);
+	printf("line=%d philos=%d died=%d elapsed_s=%.3f meals=%ld meals_min=%d "
+		"max_hunger_ms=%.3f fairness=%.4f log=%s\n", r->line,
+		r->sim->total_philos, res.died, res.elapsed / 1e6, (long)res.meals,
+		res.meals_min, res.max_hunger / 1e3, res.fairness, r->path);
+	batch_free_run(r);
+	batch_admit(b, -cost);
+	return (NULL);
+}
+
+/**
+ * Make room in 'threads' for one more run, doubling it when full.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	thread_room(t_batch *b)
+{
+	pthread_t	*threads;
+	int			capacity;
+
+	if (b->spawned < b->capacity)
+		return (0);
+	capacity = b->capacity * 2 + 16;
+	threads = realloc(b->threads, capacity * sizeof(pthread_t));
+	if (threads == NULL)
+		return (-1);
+	b->threads = threads;
+	b->capacity = capacity;
+	return (0);
+}
+
+/**
+ * Admit 'r' and start it on a thread of its own, see run_main(), which
+ * batch_run() joins.
+ *
+ * @param philos Philosophers of the run, for run_cost().
+ * @return 0 on success, -1 if the thread could not be created.
+ */
+static int	run_spawn(t_batch *b, t_batch_run *r, int philos)
+{
+	r->cost = run_cost(&b->opts, philos);
+	if (thread_room(b) == -1)
+	{
+		batch_free_run(r);
+		return (-1);
+	}
+	batch_admit(b, r->cost);
+	if (pthread_create(&b->threads[b->spawned], NULL, run_main, r) != 0)
+	{
+		batch_admit(b, -r->cost);
+		batch_free_run(r);
+		return (-1);
+	}
+	b->spawned++;
+	return (0);
+}
+
+/**
+ * Start the configuration on the next line of the batch file, once it is
+ * admitted. An invalid line or a run that cannot be started fails the
+ * batch; the other runs go on.
+ *
+ * @param b Batch in progress.
+ * @param line Line read from the batch file.
+ */
+void	batch_start(t_batch *b, char *line)
+{
+	t_batch_run	*r;
+	int			args[5];
+	int			status;
+
+	b->line++;
+	status = batch_parse_line(line, args);
+	if (status == 0)
+		return ;
+	r = NULL;
+	if (status == 1)
+		r = batch_new_run(b, args);
+	if (r == NULL || run_spawn(b, r, args[0]) == -1)
+	{
+		fprintf(stderr, "%s:%d: cannot run this configuration\n",
+			b->file, b->line);
+		atomic_store(&b->failed, true);
+	}
+}
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:07:37 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 06:54:45 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * The configurations benchmarked, taken from the no-death cases of test.sh
+ * with 'must_eat' lowered to keep each run within a few seconds, and odd
+ * tables just above the shortest 'time_to_die' they can survive, which
+ * tell the '-p' policies apart.
+ *
+ * @param row Index into the matrix.
+ * @return The arguments of row 'row', NULL past the last row.
+ */
+static const int	*bench_matrix(int row)
+{
+	static const int	matrix[][5] = {
+	{2, 130, 60, 60, 5},
+	{3, 200, 65, 65, 5},
+	{4, 410, 200, 200, 5},
+	{5, 610, 200, 200, 5},
+	{5, 800, 200, 200, 5},
+	{10, 500, 100, 100, 5},
+	{100, 410, 200, 200, 5},
+	{199, 601, 200, 100, 5},
+	{200, 800, 200, 200, 5},
+	{5, 270, 100, 100, 5},
+	{7, 250, 100, 100, 5},
+	{31, 230, 100, 100, 5},
+	{0, 0, 0, 0, 0},
+	};
+
+	if (matrix[row][0] == 0)
+		return (NULL);
+	return (matrix[row]);
+}
+
+/**
+ * Run one simulation in this process and add its figures to 'b'. The timing
+ * error is the oversleep of every wait, see wait_until(); the elapsed time
+ * is the wall clock of the whole run, thread creation and start included.
+ */
+static void	bench_run(const t_options *opts, const int config[5], t_bench *b)
+{
+	t_monitor		m;
+	t_hist			total[STAT_KINDS];
+	t_philo_results	r;
+	int				args[5];
+	int64_t			begin;
+
+	memset(&m, 0, sizeof(m));
+	m.opts = *opts;
+	memcpy(args, config, sizeof(args));
+	begin = current_time();
+	if (run_simulation(&m, args) == 0)
+	{
+		b->elapsed += current_time() - begin;
+		stats_merge(&m, total);
+		hist_merge(&b->error, &total[STAT_OVERSLEEP]);
+		philo_sim_results(&m, &r);
+		b->meals += r.meals;
+		if (atomic_load(&m.full_philos) == m.total_philos)
+			b->survived++;
+		b->runs++;
+	}
+	run_free(&m);
+}
+
+/**
+ * Print one tab-separated row of results, in the columns main() prints as
+ * the header.
+ */
+static void	print_row(const int config[5], const t_bench *b)
+{
+	double	survival;
+	double	throughput;
+
+	survival = 0;
+	throughput = 0;
+	if (b->runs > 0)
+		survival = (double)b->survived / b->runs;
+	if (b->elapsed > 0)
+		throughput = b->meals / (b->elapsed / 1e6);
+	printf("%d\t%d\t%d\t%d\t%d\t%d\t%.2f\t%ld\t%ld\t%ld\t%.1f\n",
+		config[0], config[1], config[2], config[3], config[4], b->runs,
+		survival, (long)hist_percentile(&b->error, 0.5),
+		(long)hist_percentile(&b->error, 0.99), (long)b->error.max,
+		throughput);
+	fflush(stdout);
+}
+
+/**
+ * Run configuration 'config' 'reps' times and print its row.
+ *
+ * @return true if every run was started and nobody died.
+ */
+static bool	bench_config(const t_options *opts, const int config[5], int reps)
+{
+	t_bench	b;
+	int		i;
+
+	memset(&b, 0, sizeof(b));
+	i = 0;
+	while (i++ < reps)
+		bench_run(opts, config, &b);
+	print_row(config, &b);
+	return (b.survived == reps);
+}
+
+/**
+ * philo_bench [philo options] [repetitions]: run the benchmark matrix with
+ * the given options (engine, strategy, ...), each configuration
+ * 'BENCH_REPS' times by default, and print a tab-separated table on stdout.
+ * The event log goes to /dev/null as a binary trace, the cheapest output.
+ *
+ * @return 0 if every run survived, 1 if one did not, 2 on bad usage.
+ */
+int	main(int ac, char **av)
+{
+	t_options	opts;
+	int			first;
+	int			reps;
+	int			row;
+	bool		ok;
+
+	memset(&opts, 0, sizeof(opts));
+	first = parse_options(ac, av, &opts);
+	reps = BENCH_REPS;
+	if (first != -1 && first < ac)
+		reps = parse_nbr(av[first]);
+	if (first == -1 || reps <= 0 || first + 1 < ac)
+	{
+		printf("usage: philo_bench [philo options] [repetitions]\n");
+		return (2);
+	}
+	opts.histograms = true;
+	opts.trace_file = "/dev/null";
+	printf("philos\tdie\teat\tsleep\tmust_eat\truns\tsurvival\terr_p50_us\t"
+		"err_p99_us\terr_max_us\tmeals_per_s\n");
+	ok = true;
+	row = 0;
+	while (bench_matrix(row) != NULL)
+		ok = bench_config(&opts, bench_matrix(row++), reps) && ok;
+	return (!ok);
+}
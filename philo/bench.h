@@ -0,0 +1,35 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:07:37 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 05:07:37 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_H
+# define BENCH_H
+
+# include "philo.h"
+
+# define BENCH_REPS 3					// runs per configuration by default
+
+typedef struct s_bench		t_bench;
+
+/**
+ * Figures of one configuration of the benchmark matrix, summed over its
+ * repetitions.
+ */
+struct s_bench
+{
+	t_hist				error;				// oversleep of every run, merged
+	int					runs;				// runs that could be started
+	int					survived;			// runs where everyone got full
+	int64_t				meals;
+	int64_t				elapsed;			// wall clock of the runs (us)
+};
+
+#endif
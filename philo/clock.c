@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   clock.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:23:49 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 06:04:07 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Read the monotonic clock, which unlike the wall clock never jumps when the
+ * system time is adjusted. It is served from the vDSO, so no syscall is made.
+ * (CLOCK_MONOTONIC_COARSE is cheaper still, but only ticks every few
+ * milliseconds, which is too coarse for the timestamps we print.)
+ *
+ * @return Current time in microseconds (int64_t).
+ */
+int64_t	current_time(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**
+ * Current time as the simulation sees it: the monotonic clock, or the
+ * virtual clock when the engine runs on one ('des').
+ *
+ * @param m Monitor of the run.
+ * @return Time in microseconds.
+ */
+int64_t	sim_time(t_monitor *m)
+{
+	if (m->opts.engine->virtual_clock)
+		return (m->des.now);
+	return (current_time());
+}
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   des.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:36:04 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:31:08 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Play the monitor's part on the virtual clock: settle every deadline in
+ * the heap that falls before 'limit' (see check_earliest()). Philosophers
+ * starting to eat exactly on their deadline are run first and survive.
+ *
+ * @param m Monitor owning the heap.
+ * @param limit Time of the next event, INT64_MAX when there is none.
+ * @return true if a philosopher died, false otherwise.
+ */
+static bool	des_check_death(t_monitor *m, int64_t limit)
+{
+	t_deadline *const	top = &m->deadlines[0];
+	t_philo				*p;
+	int64_t				deadline;
+
+	while (top->deadline < limit)
+	{
+		p = &m->philos[top->idx];
+		deadline = get_last_ate(p) + p->rules.time_to_die;
+		if (get_has_eaten(p) == p->rules.must_eat)
+			top->deadline = INT64_MAX;
+		else if (deadline > top->deadline)
+			top->deadline = deadline;
+		else
+		{
+			m->des.now = top->deadline;
+			if (set_stop_simulation(m))
+				philo_print(p, DEAD);
+			return (true);
+		}
+		heap_sift_down(m->deadlines, m->total_philos, 0);
+	}
+	return (false);
+}
+
+/**
+ * Run events in time order, each one a philo_step() at the event's time,
+ * until a philosopher dies or none has anything left to do. A philosopher
+ * parked on a fork has no event; the neighbour handing it over schedules
+ * one through des_wake().
+ */
+static void	des_loop(t_monitor *m)
+{
+	t_des_event	event;
+	int64_t		when;
+
+	while (m->des.size > 0)
+	{
+		if (des_check_death(m, m->des.events[0].time))
+			return ;
+		event = des_pop(&m->des);
+		m->des.now = event.time;
+		when = philo_step(&m->philos[event.idx], event.time);
+		if (when >= 0)
+			des_push(&m->des, event.idx, when);
+	}
+	des_check_death(m, INT64_MAX);
+}
+
+/**
+ * Make a parked philosopher run again at the current virtual time.
+ *
+ * @param m Monitor owning the engine state.
+ * @param idx Index of the philosopher.
+ */
+void	des_wake(t_monitor *m, int idx)
+{
+	des_push(&m->des, idx, m->des.now);
+}
+
+/**
+ * 'des' engine: run the whole simulation on the calling thread as a
+ * discrete-event simulation. The virtual clock starts at 0 and jumps from
+ * one event to the next, so waits take no time and a given seed ('-d')
+ * always produces the same log. The philosophers follow the same
+ * state machine as in the 'pool' engine, forks taken in order.
+ *
+ * @param m Monitor with the table initialized.
+ * @return 0 once the simulation is over, -1 on allocation failure.
+ */
+int	des_start(t_monitor *m)
+{
+	int	i;
+
+	engine_fallback(m);
+	m->des.events = malloc(m->total_philos * sizeof(t_des_event));
+	if (m->des.events == NULL)
+		return (-1);
+	prng_seed(&m->des.rng, m->opts.seed);
+	publish_start_time(m, THREAD_START_DELAY);
+	i = 0;
+	while (i < m->total_philos)
+		des_push(&m->des, i++, atomic_load_explicit(&m->start_time,
+				memory_order_relaxed));
+	heap_build(m, m->deadlines, m->total_philos);
+	des_loop(m);
+	return (0);
+}
+
+/**
+ * Free the event queue; nothing runs once des_start() has returned.
+ */
+void	des_stop(t_monitor *m)
+{
+	free(m->des.events);
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   des_queue.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:36:04 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:36:04 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return true if event 'a' comes before event 'b'.
+ */
+static bool	before(const t_des_event *a, const t_des_event *b)
+{
+	return (a->time < b->time || (a->time == b->time && a->key < b->key));
+}
+
+/**
+ * Move the event at 'i' up until its parent comes before it.
+ */
+static void	sift_up(t_des_event *heap, int i)
+{
+	t_des_event	tmp;
+
+	while (i > 0 && before(&heap[i], &heap[(i - 1) / 2]))
+	{
+		tmp = heap[i];
+		heap[i] = heap[(i - 1) / 2];
+		heap[(i - 1) / 2] = tmp;
+		i = (i - 1) / 2;
+	}
+}
+
+/**
+ * Move the event at 'i' down until it comes before both children.
+ */
+static void	sift_down(t_des_event *heap, int size, int i)
+{
+	t_des_event	tmp;
+	int			child;
+
+	child = 2 * i + 1;
+	while (child < size)
+	{
+		if (child + 1 < size && before(&heap[child + 1], &heap[child]))
+			child++;
+		if (before(&heap[child], &heap[i]) == false)
+			return ;
+		tmp = heap[i];
+		heap[i] = heap[child];
+		heap[child] = tmp;
+		i = child;
+		child = 2 * i + 1;
+	}
+}
+
+/**
+ * Schedule philosopher 'idx' to run at 'time'. Events due at the same time
+ * run in the order of a key drawn from the seeded generator, so the seed
+ * picks one of the possible interleavings and always the same one.
+ *
+ * @param d Engine state owning the queue.
+ * @param idx Index of the philosopher, at most one event each.
+ * @param time Virtual time in microseconds.
+ */
+void	des_push(t_des *d, int idx, int64_t time)
+{
+	d->events[d->size].time = time;
+	d->events[d->size].key = prng_next(&d->rng);
+	d->events[d->size].idx = idx;
+	sift_up(d->events, d->size);
+	d->size++;
+}
+
+/**
+ * Remove and return the earliest event. The queue must not be empty.
+ */
+t_des_event	des_pop(t_des *d)
+{
+	t_des_event	first;
+
+	first = d->events[0];
+	d->size--;
+	d->events[0] = d->events[d->size];
+	sift_down(d->events, d->size, 0);
+	return (first);
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   engine.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:51:16 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Set the initial 'last_ate' for each philosopher and then publish the shared
+ * 'start_time'. (last_ate is set to the start_time so philosophers don't
+ * immediately die of starvation) The release store on 'start_time' makes the
+ * 'last_ate' values visible to every thread that observes the start time,
+ * arranging a synchronized start across threads. The '-L' fields start
+ * with no event and no meal.
+ *
+ * @param m Monitor containing philosopher array.
+ * @param delay How far ahead of now the run starts, in microseconds.
+ */
+void	publish_start_time(t_monitor *m, int64_t delay)
+{
+	int64_t	start_time;
+	int		i;
+
+	i = 0;
+	start_time = sim_time(m) + delay;
+	while (i < m->total_philos)
+	{
+		atomic_store_explicit(&m->states[i].last_ate, start_time,
+			memory_order_relaxed);
+		atomic_store_explicit(&m->states[i].worst_margin, INT64_MAX,
+			memory_order_relaxed);
+		atomic_store_explicit(&m->states[i].doing, -1,
+			memory_order_relaxed);
+		i++;
+	}
+	atomic_store_explicit(&m->start_time, start_time, memory_order_release);
+}
+
+/**
+ * Look up an engine by the name given to '-e'.
+ *
+ * @param name Engine name.
+ * @return Matching engine, or NULL if there is none.
+ */
+const t_engine	*engine_find(const char *name)
+{
+	static const t_engine	engines[] = {
+	{"threads", threads_start, threads_stop, NULL, false},
+	{"pool", pool_start, pool_stop, pool_wake, false},
+	{"des", des_start, des_stop, des_wake, true},
+	{"procs", procs_start, procs_stop, NULL, false},
+	{NULL, NULL, NULL, NULL, false},
+	};
+	int						i;
+
+	i = 0;
+	while (engines[i].name != NULL)
+	{
+		if (strcmp(engines[i].name, name) == 0)
+			return (&engines[i]);
+		i++;
+	}
+	return (NULL);
+}
+
+/**
+ * The engines other than 'threads' take the forks in resource order,
+ * whatever '-s' asked for: 'pool' and 'des' step the philosophers as state
+ * machines, see step_take_forks(), and the other strategies' waits are not
+ * shared between the processes of 'procs'. None of them takes '-w' either:
+ * 'pool' always waits on the timer service, 'des' on its virtual clock and
+ * the children of 'procs' on their own, and 'des', all on one thread, has
+ * no philosopher to place for '-a' and '-F'. The options are replaced so
+ * the report names what ran, and each replacement is reported on stderr,
+ * as topology_build() does.
+ *
+ * @param m Monitor whose engine is starting.
+ */
+void	engine_fallback(t_monitor *m)
+{
+	if (m->opts.strategy != strategy_find("ordered"))
+	{
+		fprintf(stderr, "engine: '-e %s' takes the forks in order, using "
+			"'-s ordered'\n", m->opts.engine->name);
+		m->opts.strategy = strategy_find("ordered");
+	}
+	if (m->opts.wheel)
+	{
+		fprintf(stderr, "engine: '-e %s' times its own waits, ignoring "
+			"'-w'\n", m->opts.engine->name);
+		m->opts.wheel = false;
+	}
+	if (m->opts.engine->virtual_clock
+		&& (m->opts.affinity != AFFINITY_NONE || m->opts.fifo))
+	{
+		fprintf(stderr, "engine: '-e %s' runs on one thread, ignoring '-a' "
+			"and '-F'\n", m->opts.engine->name);
+		m->opts.affinity = AFFINITY_NONE;
+		m->opts.fifo = false;
+	}
+}
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   engine_spawn.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 06:22:01 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:52:02 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Create the thread of philosopher 'p', on its slice of the '-S' stacks
+ * when there are some.
+ *
+ * @return 0 on success, -1 on pthread_create failure.
+ */
+static int	spawn_philo(t_monitor *m, t_philo *p)
+{
+	pthread_attr_t	attr;
+	int				err;
+
+	pthread_attr_init(&attr);
+	if (m->stacks != NULL)
+		pthread_attr_setstack(&attr, m->stacks
+			+ (size_t)(p->id - 1) * m->opts.stack_size, m->opts.stack_size);
+	err = pthread_create(&p->thread, &attr, philo_main, p);
+	pthread_attr_destroy(&attr);
+	p->has_thread = (err == 0);
+	if (err != 0)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Spawner thread: create the threads of philosophers 'first', 'first' +
+ * 'spawners' and so on, where 'first' is the philosopher passed as 'arg'.
+ * The interleaving lets neighbours start at about the same time.
+ *
+ * @param arg First philosopher of the slice.
+ * @return NULL on success, non-NULL if a thread could not be created.
+ */
+static void	*spawn_main(void *arg)
+{
+	t_philo *const		first = arg;
+	t_monitor *const	m = first->monitor;
+	int					i;
+
+	i = first->id - 1;
+	while (i < m->total_philos)
+	{
+		if (spawn_philo(m, &m->philos[i]) == -1)
+			return (arg);
+		i += m->spawners;
+	}
+	return (NULL);
+}
+
+/**
+ * '-S': map every philosopher stack at once instead of one default-sized
+ * mapping per pthread_create(). The pages are faulted in lazily, by each
+ * thread as it first touches its stack. The stacks have no guard pages,
+ * so the size must cover what a philosopher thread uses.
+ *
+ * @return 0 on success or without '-S', -1 if the mapping failed.
+ */
+static int	spawn_stacks(t_monitor *m)
+{
+	if (m->opts.stack_size == 0)
+		return (0);
+	m->stacks_size = m->opts.stack_size * m->total_philos;
+	m->stacks = mmap(NULL, m->stacks_size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+	if (m->stacks == MAP_FAILED)
+	{
+		m->stacks = NULL;
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * Run 'spawners' spawner threads and wait for them.
+ *
+ * @return 0 on success, -1 if a spawner or a philosopher thread could not
+ * be created.
+ */
+static int	spawn_parallel(t_monitor *m)
+{
+	pthread_t	*spawners;
+	void		*failed;
+	int			created;
+	int			status;
+
+	spawners = malloc(m->spawners * sizeof(pthread_t));
+	if (spawners == NULL)
+		return (-1);
+	created = 0;
+	while (created < m->spawners && pthread_create(&spawners[created], NULL,
+			spawn_main, &m->philos[created]) == 0)
+		created++;
+	status = 0;
+	if (created < m->spawners)
+		status = -1;
+	while (created > 0)
+	{
+		pthread_join(spawners[--created], &failed);
+		if (failed != NULL)
+			status = -1;
+	}
+	free(spawners);
+	return (status);
+}
+
+/**
+ * Create every philosopher thread: from the calling thread for a small
+ * table, otherwise from one spawner thread per online CPU, each creating
+ * at least 'SPAWN_SLICE' of them, since pthread_create() is mostly spent
+ * in the kernel and a thousand of them in a row take a while.
+ *
+ * @param m Monitor with the table initialized.
+ * @return 0 on success, -1 on failure.
+ */
+int	spawn_philos(t_monitor *m)
+{
+	if (spawn_stacks(m) == -1)
+		return (-1);
+	m->spawners = sysconf(_SC_NPROCESSORS_ONLN);
+	if (m->spawners > m->total_philos / SPAWN_SLICE)
+		m->spawners = m->total_philos / SPAWN_SLICE;
+	if (m->spawners > 1)
+		return (spawn_parallel(m));
+	m->spawners = 1;
+	if (spawn_main(&m->philos[0]) != NULL)
+		return (-1);
+	return (0);
+}
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   engine_threads.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:41:14 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 06:24:26 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Timer callback of the 'threads' engine: wake the philosopher thread
+ * blocked on its timer in wait_until().
+ *
+ * @param m Monitor owning the philosophers.
+ * @param idx Index of the philosopher.
+ */
+void	threads_wake(t_monitor *m, int idx)
+{
+	sem_post(&m->philos[idx].wakeup);
+}
+
+/**
+ * 'threads' engine: create one thread per philosopher running philo_main(),
+ * see spawn_philos(), and set them in motion at the start gate once all of
+ * them are parked there, see gate_open(). With '-w' their timed waits go
+ * through the timer service, started first.
+ *
+ * @param m Monitor with the table initialized.
+ * @return 0 on success, -1 on pthread_create failure.
+ */
+int	threads_start(t_monitor *m)
+{
+	if (m->opts.wheel && timers_start(&m->timers, m, threads_wake) == -1)
+		return (-1);
+	if (spawn_philos(m) == -1)
+	{
+		printf("error: pthread_create failure");
+		return (-1);
+	}
+	gate_open(m);
+	return (0);
+}
+
+/**
+ * Join the philosopher threads; the stop flag is already raised. With '-w',
+ * close the timer service first and post every philosopher once, so those
+ * blocked on a timer that will never fire return right away. The '-S'
+ * stacks are unmapped once nothing runs on them.
+ */
+void	threads_stop(t_monitor *m)
+{
+	int	i;
+
+	i = 0;
+	if (m->opts.wheel)
+	{
+		timers_stop(&m->timers);
+		while (i < m->total_philos)
+			sem_post(&m->philos[i++].wakeup);
+		i = 0;
+	}
+	while (i < m->total_philos)
+	{
+		if (m->philos[i].has_thread)
+			pthread_join(m->philos[i].thread, NULL);
+		i++;
+	}
+	if (m->stacks != NULL)
+		munmap(m->stacks, m->stacks_size);
+	m->stacks = NULL;
+}
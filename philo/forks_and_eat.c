@@ -6,60 +6,114 @@
 /*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/11/28 17:29:56 by tpirinen          #+#    #+#             */
-/*   Updated: 2026/01/05 15:35:03 by tpirinen         ###   ########.fr       */
+/*   Updated: 2026/10/17 08:29:43 by tpirinen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /**
- * Acquire the two fork mutexes for the philosopher and print take-fork
- * events.
+ * Add one hungry-to-eating wait to the philosopher's counters and to its
+ * fork_wait histogram.
+ *
+ * @param p Philosopher that got its forks.
+ * @param wait Time spent waiting in microseconds.
+ */
+void	record_wait(t_philo *p, int64_t wait)
+{
+	p->state->total_wait += wait;
+	if (wait > p->state->max_wait)
+		p->state->max_wait = wait;
+	stats_record(p, STAT_FORK_WAIT, wait);
+}
+
+/**
+ * Acquire both forks with the selected strategy, which also prints the
+ * take-fork events, and record how long the philosopher waited. A wait
+ * cut short by a stop is not recorded.
  *
  * @param p Philosopher taking the forks.
  */
 void	take_forks(t_philo *p)
 {
-	if (p->id == p->monitor->total_philos)
-	{
-		pthread_mutex_lock(p->fork1);
-		philo_print(p, TOOK_FORK);
-		pthread_mutex_lock(p->fork2);
-		philo_print(p, TOOK_FORK);
-	}
-	else
+	int64_t	hungry_since;
+
+	hungry_since = current_time();
+	p->monitor->opts.strategy->take(p);
+	if (get_stop_simulation(p) == false)
+		record_wait(p, current_time() - hungry_since);
+}
+
+/**
+ * Print the eating event, record how long the philosopher went hungry and
+ * how much time it had left to live (the least of which '-L' shows), and
+ * publish 'last_ate'. 'last_ate' is taken after the event is queued so the
+ * printed meal never starts later than the one the monitor sees.
+ * Only the owner writes these fields, so a plain atomic store suffices and
+ * the monitor reads them without taking a lock.
+ *
+ * @param p Philosopher starting to eat.
+ */
+void	meal_begin(t_philo *p)
+{
+	int64_t	now;
+	int64_t	margin;
+
+	philo_print(p, EATING);
+	now = sim_time(p->monitor);
+	margin = get_last_ate(p) + p->rules.time_to_die - now;
+	stats_record(p, STAT_EAT_MARGIN, margin);
+	if (margin < atomic_load_explicit(&p->state->worst_margin,
+			memory_order_relaxed))
+		atomic_store_explicit(&p->state->worst_margin, margin,
+			memory_order_relaxed);
+	if (now - get_last_ate(p) > p->state->max_hunger)
+		p->state->max_hunger = now - get_last_ate(p);
+	atomic_store_explicit(&p->state->last_ate, now, memory_order_release);
+}
+
+/**
+ * Bump 'has_eaten' once the forks are back on the table. Reaching
+ * 'must_eat' is reported to the monitor so it can stop waiting on this
+ * philosopher.
+ *
+ * @param p Philosopher done eating.
+ * @return 'FULL' if the philosopher reached 'must_eat', otherwise 'KEEP_EATING'
+ */
+int	meal_end(t_philo *p)
+{
+	int	has_eaten;
+
+	has_eaten = get_has_eaten(p) + 1;
+	atomic_store_explicit(&p->state->has_eaten, has_eaten,
+		memory_order_release);
+	if (has_eaten == p->rules.must_eat)
 	{
-		pthread_mutex_lock(p->fork2);
-		philo_print(p, TOOK_FORK);
-		pthread_mutex_lock(p->fork1);
-		philo_print(p, TOOK_FORK);
+		monitor_notify_full(p->monitor);
+		return (FULL);
 	}
+	return (KEEP_EATING);
 }
 
 /**
- * Update 'last_ate', sleep for 'time_to_eat', release forks,
- * update 'access_granted' and 'has_eaten', and indicate whether the
- * philosopher has reached its required eat count.
+ * Eat for as long as the philosopher's (eat) draws, release the forks and
+ * indicate whether the philosopher has reached its required eat count.
+ * Once the run stopped there is no meal: a strategy whose 'take' was
+ * interrupted may not hold the forks, and its 'put' only has to leave
+ * them consistent for the other stopping philosophers.
  *
  * @param p Philosopher eating.
  * @return 'FULL' if the philosopher reached 'must_eat', otherwise 'KEEP_EATING'
  */
 int	eat_and_check_saturation(t_philo *p)
 {
-	philo_print(p, EATING);
-	pthread_mutex_lock(&p->monitor->philo_mutex);
-	p->last_ate = current_time();
-	pthread_mutex_unlock(&p->monitor->philo_mutex);
-	wait_for(p, p->time_to_eat);
-	pthread_mutex_unlock(p->fork1);
-	pthread_mutex_unlock(p->fork2);
-	pthread_mutex_lock(&p->monitor->philo_mutex);
-	p->has_eaten++;
-	if (p->has_eaten == p->must_eat)
+	if (get_stop_simulation(p) == true)
 	{
-		pthread_mutex_unlock(&p->monitor->philo_mutex);
-		return (FULL);
+		p->monitor->opts.strategy->put(p);
+		return (KEEP_EATING);
 	}
-	pthread_mutex_unlock(&p->monitor->philo_mutex);
-	return (KEEP_EATING);
+	meal_begin(p);
+	wait_for(p, prng_duration(&p->rng, &p->eat));
+	p->monitor->opts.strategy->put(p);
+	return (meal_end(p));
 }
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   futex.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 06:21:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:22:31 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Issue futex operation 'op' on 'word', with an absolute deadline on the
+ * clock of current_time() when 'target_time' is not 0.
+ */
+static void	futex_call(atomic_uint *word, int op, unsigned int value,
+	int64_t target_time)
+{
+	struct timespec	ts;
+	struct timespec	*deadline;
+
+	deadline = NULL;
+	if (target_time > 0)
+	{
+		ts.tv_sec = target_time / 1000000;
+		ts.tv_nsec = (target_time % 1000000) * 1000;
+		deadline = &ts;
+	}
+	syscall(SYS_futex, word, op, value, deadline, NULL,
+		FUTEX_BITSET_MATCH_ANY);
+}
+
+/**
+ * Sleep while '*word' still holds 'seen', until futex_wake() is called on
+ * it or until 'target_time'. Returns early on a signal or a spurious wakeup,
+ * so callers check their condition again in a loop.
+ *
+ * @param word Futex word.
+ * @param seen Value the caller last read from it.
+ * @param target_time Absolute time in microseconds on the clock of
+ * current_time(), 0 to sleep without a deadline.
+ */
+void	futex_wait(atomic_uint *word, unsigned int seen, int64_t target_time)
+{
+	futex_call(word, FUTEX_WAIT_BITSET_PRIVATE, seen, target_time);
+}
+
+/**
+ * Wake every thread sleeping in futex_wait() on 'word'.
+ */
+void	futex_wake(atomic_uint *word)
+{
+	futex_call(word, FUTEX_WAKE_PRIVATE, INT_MAX, 0);
+}
+
+/**
+ * futex_wait() on a word in memory shared between processes, see
+ * 't_shared'. The private operations only match waiters of the same
+ * process.
+ */
+void	futex_wait_shared(atomic_uint *word, unsigned int seen,
+	int64_t target_time)
+{
+	futex_call(word, FUTEX_WAIT_BITSET, seen, target_time);
+}
+
+/**
+ * futex_wake() for futex_wait_shared().
+ */
+void	futex_wake_shared(atomic_uint *word)
+{
+	futex_call(word, FUTEX_WAKE, INT_MAX, 0);
+}
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   gate.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 06:21:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 06:31:51 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Start gate of the 'threads' engine, on the philosopher's side: check in,
+ * sleep on the gate until gate_open() publishes the start time (or the run
+ * is stopped), then sleep until that start time.
+ *
+ * @param p Philosopher, called from its own thread.
+ */
+void	wait_for_start_time(t_philo *p)
+{
+	t_monitor *const	m = p->monitor;
+
+	if (atomic_fetch_add_explicit(&m->ready, 1, memory_order_acq_rel) + 1
+		== (unsigned int)m->total_philos)
+		futex_wake(&m->ready);
+	while (atomic_load_explicit(&m->gate, memory_order_acquire) == 0)
+		futex_wait(&m->gate, 0, 0);
+	wait_until(p, get_start_time(p));
+}
+
+/**
+ * Start gate on the monitor's side: wait until every philosopher thread
+ * has checked in, so all of them are running and parked, then publish a
+ * start time just far enough ahead for the last one to be woken in time
+ * and open the gate with one wakeup. The wait is rechecked every
+ * 'MONITOR_MAX_SLEEP' in case the run is stopped meanwhile.
+ *
+ * @param m Monitor, once every philosopher thread has been created.
+ */
+void	gate_open(t_monitor *m)
+{
+	unsigned int	ready;
+
+	ready = atomic_load_explicit(&m->ready, memory_order_acquire);
+	while (ready < (unsigned int)m->total_philos
+		&& atomic_load_explicit(&m->stop_simulation, memory_order_acquire) == 0)
+	{
+		futex_wait(&m->ready, ready, current_time() + MONITOR_MAX_SLEEP);
+		ready = atomic_load_explicit(&m->ready, memory_order_acquire);
+	}
+	publish_start_time(m, GATE_MARGIN + GATE_MARGIN_PER_PHILO
+		* (int64_t)m->total_philos);
+	atomic_fetch_or_explicit(&m->gate, GATE_OPEN, memory_order_release);
+	futex_wake(&m->gate);
+}
@@ -6,28 +6,64 @@
 /*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/05 19:15:26 by tpirinen          #+#    #+#             */
-/*   Updated: 2026/01/05 15:35:21 by tpirinen         ###   ########.fr       */
+/*   Updated: 2026/10/17 06:20:16 by tpirinen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
+/**
+ * The stop flag is a single word shared by every thread, so reading it costs
+ * one acquire load instead of a trip through a mutex.
+ *
+ * @param p Philosopher asking.
+ * @return true once the simulation has been stopped.
+ */
 bool	get_stop_simulation(t_philo *p)
 {
-	bool	stop_simulation;
+	return (atomic_load_explicit(&p->monitor->stop_simulation,
+			memory_order_acquire));
+}
 
-	pthread_mutex_lock(&p->monitor->philo_mutex);
-	stop_simulation = p->stop_simulation;
-	pthread_mutex_unlock(&p->monitor->philo_mutex);
-	return (stop_simulation);
+/**
+ * Raise the stop flag. Only the first caller sees the flag go from 0 to 1,
+ * which makes it the arbiter for who gets to report a death. Sleepers are
+ * only woken by stop_broadcast(), once the death is in the log, so nothing
+ * woken early can print ahead of it.
+ *
+ * @param m Monitor owning the flag.
+ * @return true if this call stopped the simulation, false if it already was.
+ */
+bool	set_stop_simulation(t_monitor *m)
+{
+	if (atomic_exchange_explicit(&m->stop_simulation, 1,
+			memory_order_acq_rel) != 0)
+		return (false);
+	atomic_store_explicit(&m->stop_time, current_time(), memory_order_relaxed);
+	return (true);
 }
 
+/**
+ * @return Start time published by the monitor, 0 while not yet published.
+ */
 int64_t	get_start_time(t_philo *p)
 {
-	int64_t	start_time;
+	return (atomic_load_explicit(&p->monitor->start_time,
+			memory_order_acquire));
+}
 
-	pthread_mutex_lock(&p->monitor->philo_mutex);
-	start_time = p->start_time;
-	pthread_mutex_unlock(&p->monitor->philo_mutex);
-	return (start_time);
+/**
+ * @return Time of the philosopher's latest meal in microseconds.
+ */
+int64_t	get_last_ate(t_philo *p)
+{
+	return (atomic_load_explicit(&p->state->last_ate, memory_order_acquire));
+}
+
+/**
+ * @return Number of meals the philosopher has finished.
+ */
+int	get_has_eaten(t_philo *p)
+{
+	return (atomic_load_explicit(&p->state->has_eaten, memory_order_acquire));
 }
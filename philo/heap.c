@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   heap.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:27:40 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:09:09 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Restore the heap property below 'i' after its deadline was increased.
+ * Deadlines only ever move later (a philosopher eating pushes its own
+ * deadline forward), so sifting down is the only operation ever needed.
+ *
+ * @param heap Array of deadlines ordered as a binary min-heap.
+ * @param size Number of entries in the heap.
+ * @param i Index of the entry whose key grew.
+ */
+void	heap_sift_down(t_deadline *heap, int size, int i)
+{
+	t_deadline	tmp;
+	int			child;
+
+	child = 2 * i + 1;
+	while (child < size)
+	{
+		if (child + 1 < size && heap[child + 1].deadline < heap[child].deadline)
+			child++;
+		if (heap[i].deadline <= heap[child].deadline)
+			return ;
+		tmp = heap[i];
+		heap[i] = heap[child];
+		heap[child] = tmp;
+		i = child;
+		child = 2 * i + 1;
+	}
+}
+
+/**
+ * Fill 'heap', a range of the monitor's deadlines, with the death deadline
+ * 'last_ate + time_to_die' of the philosophers of the same range, and
+ * heapify it.
+ *
+ * @param m Monitor owning the heap, after 'start_time' has been published.
+ * @param heap Entries of (deadlines) to fill, the whole array for one heap.
+ * @param count Number of entries, and of philosophers.
+ */
+void	heap_build(t_monitor *m, t_deadline *heap, int count)
+{
+	const int	first = heap - m->deadlines;
+	int			i;
+
+	i = 0;
+	while (i < count)
+	{
+		heap[i].idx = first + i;
+		heap[i].deadline = get_last_ate(&m->philos[first + i])
+			+ m->philos[first + i].rules.time_to_die;
+		i++;
+	}
+	i = count / 2 - 1;
+	while (i >= 0)
+		heap_sift_down(heap, count, i--);
+}
@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hist.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:53:16 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:53:16 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Bucket of 'value': values below 'HIST_SUB_COUNT' get a bucket each, larger
+ * ones are split on their highest set bit and the 'HIST_SUB_BITS' bits
+ * below it.
+ */
+static int	hist_index(int64_t value)
+{
+	int	bit;
+
+	if (value < HIST_SUB_COUNT)
+		return (value);
+	bit = HIST_SUB_BITS;
+	while ((value >> (bit + 1)) != 0)
+		bit++;
+	return ((bit - HIST_SUB_BITS + 1) * HIST_SUB_COUNT
+		+ ((value >> (bit - HIST_SUB_BITS)) & (HIST_SUB_COUNT - 1)));
+}
+
+/**
+ * Largest value that falls into bucket 'idx', used when reporting it.
+ *
+ * @param idx Bucket index, below 'HIST_BUCKETS'.
+ * @return Value in the histogram's unit.
+ */
+int64_t	hist_bucket_value(int idx)
+{
+	int	shift;
+
+	if (idx < HIST_SUB_COUNT)
+		return (idx);
+	shift = idx / HIST_SUB_COUNT - 1;
+	return (((int64_t)(idx % HIST_SUB_COUNT + HIST_SUB_COUNT + 1) << shift)
+		- 1);
+}
+
+/**
+ * Count one sample. Negative values count as 0, values too large for the
+ * last bucket land in it; 'min' and 'max' stay exact either way.
+ *
+ * @param h Histogram owned by the calling thread.
+ * @param value Sample in microseconds.
+ */
+void	hist_record(t_hist *h, int64_t value)
+{
+	if (value < 0)
+		value = 0;
+	if (h->count == 0 || value < h->min)
+		h->min = value;
+	if (value > h->max)
+		h->max = value;
+	h->count++;
+	h->sum += value;
+	if (value >= (int64_t)1 << HIST_MAX_BITS)
+		value = ((int64_t)1 << HIST_MAX_BITS) - 1;
+	h->buckets[hist_index(value)]++;
+}
+
+/**
+ * Add every sample of 'src' to 'dst'.
+ */
+void	hist_merge(t_hist *dst, const t_hist *src)
+{
+	int	i;
+
+	if (src->count == 0)
+		return ;
+	if (dst->count == 0 || src->min < dst->min)
+		dst->min = src->min;
+	if (src->max > dst->max)
+		dst->max = src->max;
+	dst->count += src->count;
+	dst->sum += src->sum;
+	i = 0;
+	while (i < HIST_BUCKETS)
+	{
+		dst->buckets[i] += src->buckets[i];
+		i++;
+	}
+}
+
+/**
+ * Value at or below which a fraction 'q' of the samples lie, to within the
+ * precision of a bucket and never above the largest sample.
+ *
+ * @param h Histogram to read.
+ * @param q Fraction between 0 and 1, e.g. 0.99 for the 99th percentile.
+ * @return The percentile, 0 for an empty histogram.
+ */
+int64_t	hist_percentile(const t_hist *h, double q)
+{
+	int64_t	rank;
+	int64_t	seen;
+	int		i;
+
+	if (h->count == 0)
+		return (0);
+	rank = (int64_t)(q * h->count + 0.5);
+	if (rank < 1)
+		rank = 1;
+	seen = 0;
+	i = 0;
+	while (i < HIST_BUCKETS - 1 && seen + h->buckets[i] < rank)
+		seen += h->buckets[i++];
+	if (hist_bucket_value(i) > h->max)
+		return (h->max);
+	return (hist_bucket_value(i));
+}
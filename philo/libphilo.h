@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   libphilo.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:12:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LIBPHILO_H
+# define LIBPHILO_H
+
+# include <stdint.h>	//	- int64_t
+# include <stdbool.h>	//	- type bool
+
+typedef struct s_monitor		t_philo_sim;
+typedef struct s_event			t_philo_event;
+typedef struct s_philo_config	t_philo_config;
+typedef struct s_philo_results	t_philo_results;
+typedef void					(*t_philo_event_fn)(void *ctx,
+									const t_philo_event *event);
+
+/**
+ * One state change of a philosopher, as passed to the event callback.
+ */
+struct s_event
+{
+	int64_t				time;				// microseconds since start_time
+	int					id;					// id of the philo
+	int					state;				// enum e_state
+};
+
+/**
+ * A simulation to run, see philo_sim_configure(). Times are in
+ * milliseconds like on the command line; the optional fields may be left
+ * zero.
+ */
+struct s_philo_config
+{
+	int					philos;
+	int					time_to_die;
+	int					time_to_eat;
+	int					time_to_sleep;
+	int					must_eat;			// 0 to run until someone dies
+	const char			*engine;			// "threads" when NULL
+	const char			*strategy;			// "ordered" when NULL
+	int					workers;			// 'pool': one per CPU when 0
+	unsigned int		seed;				// 'des': tie-breaking seed
+	bool				wheel;				// 'threads' wait on a timer wheel
+	const char			*topology;			// '-g', "ring" when NULL
+	const char			*profile;			// '-P', per-philosopher timings
+};
+
+/**
+ * What a finished run produced, see philo_sim_results(). Times are in
+ * microseconds.
+ */
+struct s_philo_results
+{
+	int64_t				elapsed;			// start_time to the end of the run
+	int64_t				meals;				// by every philosopher together
+	int					meals_min;
+	int					meals_max;
+	double				fairness;			// Jain's index of the meal counts
+	int64_t				total_wait;			// hungry to eating, summed
+	int64_t				max_wait;			// hungry to eating, worst case
+	int64_t				max_hunger;			// between meals, worst case
+	int					died;				// id of the philo that died, or 0
+	int64_t				death_time;			// since start_time, when 'died'
+	int64_t				detect_latency;		// deadline to 'died' noticed
+	int64_t				stop_latency;		// stop or death to all joined
+	int64_t				startup;			// philo_sim_create() to start_time
+};
+
+enum e_state
+{
+	TOOK_FORK,
+	EATING,
+	SLEEPING,
+	THINKING,
+	DEAD,
+};
+
+// Lifecycle: create, configure or parse, optionally set a callback, run,
+// read the results, destroy. philo_sim_stop() may be called from any thread.
+t_philo_sim	*philo_sim_create(void);
+int			philo_sim_configure(t_philo_sim *sim, const t_philo_config *c);
+int			philo_sim_parse(t_philo_sim *sim, int ac, char **av);
+void		philo_sim_on_event(t_philo_sim *sim, t_philo_event_fn fn,
+				void *ctx);
+int			philo_sim_run(t_philo_sim *sim);
+void		philo_sim_stop(t_philo_sim *sim);
+void		philo_sim_results(t_philo_sim *sim, t_philo_results *out);
+void		philo_sim_destroy(t_philo_sim *sim);
+
+#endif
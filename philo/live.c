@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   live.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:54:52 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:54:52 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * '-L <file>': create the live stats file, sized for the table, and map it
+ * shared so philo_top sees every update, see live_start().
+ *
+ * @param m Monitor with the philosophers and the rules initialized.
+ * @return 0 on success or without '-L', -1 if the file can't be written.
+ */
+int	live_open(t_monitor *m)
+{
+	t_live *const	l = &m->live;
+	int				fd;
+
+	if (m->opts.live_file == NULL)
+		return (0);
+	l->size = sizeof(t_live_header) + m->total_philos * sizeof(t_live_philo);
+	fd = open(m->opts.live_file, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1 || ftruncate(fd, l->size) == -1)
+		l->map = MAP_FAILED;
+	else
+		l->map = mmap(NULL, l->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+				fd, 0);
+	if (fd != -1)
+		close(fd);
+	if (l->map == MAP_FAILED)
+	{
+		l->map = NULL;
+		printf("error: cannot write %s\n", m->opts.live_file);
+		return (-1);
+	}
+	l->map->philos = m->total_philos;
+	l->map->pid = getpid();
+	l->map->time_to_die = m->rules.time_to_die;
+	l->map->must_eat = m->rules.must_eat;
+	return (0);
+}
+
+/**
+ * Thread updating the live stats file every LIVE_INTERVAL until the run is
+ * stopped. It runs under SCHED_IDLE when the system allows it, so it only
+ * gets CPU time nothing else wants and never delays a philosopher; it
+ * reads their states with relaxed loads and never takes a lock.
+ */
+static void	*live_main(void *arg)
+{
+	t_monitor *const	m = arg;
+	struct sched_param	param;
+
+	memset(&param, 0, sizeof(param));
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+	while (atomic_load_explicit(&m->stop_simulation, memory_order_acquire)
+		== 0)
+	{
+		live_publish(m, LIVE_RUNNING);
+		stop_sleep_until(m, current_time() + LIVE_INTERVAL);
+	}
+	return (NULL);
+}
+
+/**
+ * Fill in what does not change, publish a first update and start
+ * live_main(), once the engine has the philosophers running. The magic
+ * number is written last, so philo_top never reads a half-made head.
+ *
+ * @return 0 on success or without '-L', -1 if the thread can't be created.
+ */
+int	live_start(t_monitor *m)
+{
+	t_live *const	l = &m->live;
+	t_live_philo	*slots;
+	int				i;
+
+	if (l->map == NULL)
+		return (0);
+	slots = (t_live_philo *)(l->map + 1);
+	i = 0;
+	while (i < m->total_philos)
+	{
+		slots[i].time_to_die = m->philos[i].rules.time_to_die;
+		slots[i].must_eat = m->philos[i].rules.must_eat;
+		i++;
+	}
+	live_publish(m, LIVE_RUNNING);
+	l->map->version = LIVE_VERSION;
+	atomic_thread_fence(memory_order_release);
+	l->map->magic = LIVE_MAGIC;
+	if (pthread_create(&l->thread, NULL, live_main, m) != 0)
+		return (-1);
+	l->started = true;
+	return (0);
+}
+
+/**
+ * Wait for live_main() to notice the stop, before the engine takes the
+ * philosophers' states away.
+ */
+void	live_stop(t_monitor *m)
+{
+	if (m->live.started)
+		pthread_join(m->live.thread, NULL);
+	m->live.started = false;
+}
+
+/**
+ * Publish the final figures, once every philosopher is done, mark the run
+ * as stopped for philo_top and unmap the file, which stays readable.
+ */
+void	live_close(t_monitor *m)
+{
+	if (m->live.map == NULL)
+		return ;
+	if (m->live.map->magic == LIVE_MAGIC)
+		live_publish(m, LIVE_STOPPED);
+	munmap(m->live.map, m->live.size);
+	m->live.map = NULL;
+}
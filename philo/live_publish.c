@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   live_publish.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:54:52 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:56:53 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Current time of the run: the clock, or on the virtual clock of 'des',
+ * which only its own loop may read, the latest meal of the table.
+ */
+static int64_t	live_now(t_monitor *m)
+{
+	int64_t	now;
+	int64_t	ate;
+	int		i;
+
+	if (m->opts.engine->virtual_clock == false)
+		return (current_time());
+	now = 0;
+	i = 0;
+	while (i < m->total_philos)
+	{
+		ate = atomic_load_explicit(&m->states[i++].last_ate,
+				memory_order_relaxed);
+		if (ate > now)
+			now = ate;
+	}
+	return (now);
+}
+
+/**
+ * Copy one philosopher's hot state to its slot of the live stats file.
+ *
+ * @param now Time of the update, see live_now().
+ * @return Events the philosopher printed so far.
+ */
+static int64_t	live_philo(t_live_philo *slot, t_philo_state *s, int64_t now)
+{
+	int64_t	events;
+	int64_t	hunger;
+
+	events = atomic_load_explicit(&s->events, memory_order_relaxed);
+	hunger = now - atomic_load_explicit(&s->last_ate, memory_order_relaxed);
+	if (hunger < 0)
+		hunger = 0;
+	atomic_store_explicit(&slot->meals, atomic_load_explicit(&s->has_eaten,
+			memory_order_relaxed), memory_order_relaxed);
+	atomic_store_explicit(&slot->doing, atomic_load_explicit(&s->doing,
+			memory_order_relaxed), memory_order_relaxed);
+	atomic_store_explicit(&slot->events, events, memory_order_relaxed);
+	atomic_store_explicit(&slot->hunger, hunger, memory_order_relaxed);
+	atomic_store_explicit(&slot->worst_margin, atomic_load_explicit(
+			&s->worst_margin, memory_order_relaxed), memory_order_relaxed);
+	return (events);
+}
+
+/**
+ * Publish how the run is ending: the full count, and the philosopher whose
+ * death was logged marked as dead, since it may have gone on printing,
+ * unlogged, before it noticed the stop.
+ */
+static void	live_outcome(t_monitor *m)
+{
+	t_live_philo *const	slots = (t_live_philo *)(m->live.map + 1);
+
+	atomic_store_explicit(&m->live.map->full, atomic_load_explicit(
+			&m->full_philos, memory_order_relaxed), memory_order_relaxed);
+	pthread_mutex_lock(&m->log.mutex);
+	if (m->log.death.state == DEAD)
+		atomic_store_explicit(&slots[m->log.death.id - 1].doing, DEAD,
+			memory_order_relaxed);
+	pthread_mutex_unlock(&m->log.mutex);
+}
+
+/**
+ * Copy every philosopher's state to the live stats file, then the totals
+ * and 'status', and bump 'updates' last so philo_top can tell a new
+ * update from the one it saw. Nothing is copied before the run started.
+ *
+ * @param m Monitor with '-L' open, see live_open().
+ * @param status enum e_live to publish.
+ */
+void	live_publish(t_monitor *m, int status)
+{
+	t_live_header *const	h = m->live.map;
+	int64_t					start;
+	int64_t					now;
+	int64_t					events;
+	int						i;
+
+	start = atomic_load_explicit(&m->start_time, memory_order_acquire);
+	if (start != 0)
+	{
+		now = live_now(m);
+		events = 0;
+		i = 0;
+		while (i < m->total_philos)
+		{
+			events += live_philo((t_live_philo *)(h + 1) + i,
+					&m->states[i], now);
+			i++;
+		}
+		atomic_store_explicit(&h->elapsed, now - start, memory_order_relaxed);
+		atomic_store_explicit(&h->events, events, memory_order_relaxed);
+		live_outcome(m);
+	}
+	atomic_store_explicit(&h->status, status, memory_order_relaxed);
+	atomic_fetch_add_explicit(&h->updates, 1, memory_order_release);
+}
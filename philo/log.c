@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:19:44 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:22:31 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Initialize the event ring and start the writer thread, which writes to
+ * stdout unless trace_open() pointed the log at a trace file.
+ *
+ * @param log Log to start, zeroed by the caller.
+ * @return 0 on success, -1 on pthread_create failure.
+ */
+int	log_start(t_log *log)
+{
+	if (log->binary == false)
+		log->fd = STDOUT_FILENO;
+	pthread_mutex_init(&log->mutex, NULL);
+	pthread_cond_init(&log->not_empty, NULL);
+	pthread_cond_init(&log->not_full, NULL);
+	if (pthread_create(&log->thread, NULL, log_writer_main, log) > 0)
+	{
+		printf("error: pthread_create failure");
+		return (-1);
+	}
+	log->started = true;
+	return (0);
+}
+
+/**
+ * Wait until the ring has room, with 'log->mutex' held.
+ *
+ * @param log Log to append to.
+ * @return The free slot, NULL once a death has been recorded: every
+ * further event is dropped, so 'died' is always the last line.
+ */
+t_event	*log_slot(t_log *log)
+{
+	while (log->death.state != DEAD
+		&& log->tail - log->head == LOG_CAPACITY)
+		pthread_cond_wait(&log->not_full, &log->mutex);
+	if (log->death.state == DEAD)
+		return (NULL);
+	return (&log->ring[log->tail & (LOG_CAPACITY - 1)]);
+}
+
+/**
+ * Hand the event filled in at log_slot() to the writer, with 'log->mutex'
+ * held. A death is kept for philo_sim_results().
+ *
+ * @param log Log appended to.
+ * @param event Slot from log_slot().
+ */
+void	log_commit(t_log *log, t_event *event)
+{
+	if (event->state == DEAD)
+		log->death = *event;
+	log->tail++;
+	if (log->writer_idle == true)
+		pthread_cond_signal(&log->not_empty);
+}
+
+/**
+ * Append a state change to the ring. The timestamp is taken inside the
+ * critical section so records stay in chronological order, but formatting
+ * and writing happen later on the writer thread. Producers only block when
+ * the ring is full. In a child of the 'procs' engine the event goes to the
+ * parent's log instead, see relay_push().
+ *
+ * @param m Monitor owning the log and the start time.
+ * @param id Id of the philosopher.
+ * @param state State enumerator indicating which message to print.
+ */
+void	log_push(t_monitor *m, int id, enum e_state state)
+{
+	t_log *const	log = &m->log;
+	t_event			*event;
+
+	if (m->procs.child)
+	{
+		relay_push(m, id, state);
+		return ;
+	}
+	pthread_mutex_lock(&log->mutex);
+	event = log_slot(log);
+	if (event != NULL)
+	{
+		event->time = sim_time(m) - atomic_load_explicit(&m->start_time,
+				memory_order_relaxed);
+		event->id = id;
+		event->state = state;
+		log_commit(log, event);
+	}
+	pthread_mutex_unlock(&log->mutex);
+}
+
+/**
+ * Tell the writer that no more records will come, wait for it to flush
+ * everything still in the ring and release the log resources, closing the
+ * trace file if there is one.
+ *
+ * @param log Log to close.
+ */
+void	log_close(t_log *log)
+{
+	if (log->started == true)
+	{
+		pthread_mutex_lock(&log->mutex);
+		log->closed = true;
+		pthread_cond_signal(&log->not_empty);
+		pthread_mutex_unlock(&log->mutex);
+		pthread_join(log->thread, NULL);
+		log->started = false;
+	}
+	pthread_cond_destroy(&log->not_full);
+	pthread_cond_destroy(&log->not_empty);
+	pthread_mutex_destroy(&log->mutex);
+	if (log->binary == true)
+		close(log->fd);
+}
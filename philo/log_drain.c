@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_drain.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:12:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 05:12:33 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Write 'len' bytes from 'buf' to the log's output, retrying partial writes.
+ */
+static void	flush_out(t_log *log, const char *buf, size_t len)
+{
+	ssize_t	written;
+	size_t	offset;
+
+	offset = 0;
+	while (offset < len)
+	{
+		written = write(log->fd, buf + offset, len - offset);
+		if (written <= 0)
+			return ;
+		offset += written;
+	}
+}
+
+/**
+ * '-t': write the records in [head, tail) as they are, straight from the
+ * ring, in at most two writes when the range wraps around its end.
+ */
+static void	drain_binary(t_log *log, uint64_t head, uint64_t tail)
+{
+	uint64_t	end;
+
+	while (head != tail)
+	{
+		end = (head | (LOG_CAPACITY - 1)) + 1;
+		if (end > tail)
+			end = tail;
+		flush_out(log, (const char *)&log->ring[head & (LOG_CAPACITY - 1)],
+			(end - head) * sizeof(t_event));
+		head = end;
+	}
+}
+
+/**
+ * Format the records in [head, tail) and flush them in as few writes as
+ * the output buffer allows.
+ */
+static void	drain_text(t_log *log, uint64_t head, uint64_t tail)
+{
+	int	len;
+
+	len = 0;
+	while (head != tail)
+	{
+		if (len > LOG_BUFFER_SIZE - 64)
+		{
+			flush_out(log, log->out, len);
+			len = 0;
+		}
+		len += log_format_event(log->out + len,
+				&log->ring[head & (LOG_CAPACITY - 1)]);
+		head++;
+	}
+	flush_out(log, log->out, len);
+}
+
+/**
+ * philo_sim_on_event(): hand the records in [head, tail) to the callback,
+ * one at a time and in order.
+ */
+static void	drain_sink(t_log *log, uint64_t head, uint64_t tail)
+{
+	while (head != tail)
+	{
+		log->sink(log->sink_ctx, &log->ring[head & (LOG_CAPACITY - 1)]);
+		head++;
+	}
+}
+
+/**
+ * Deliver the records in [head, tail) to the event callback if there is
+ * one, else to the '-t' trace or as text to stdout. The slots are not
+ * reused by producers until 'head' is advanced, so no lock is needed here.
+ *
+ * @param log Log being drained, by its writer thread.
+ * @param head First record to deliver.
+ * @param tail One past the last record to deliver.
+ */
+void	log_drain(t_log *log, uint64_t head, uint64_t tail)
+{
+	if (log->sink != NULL)
+		drain_sink(log, head, tail);
+	else if (log->binary == true)
+		drain_binary(log, head, tail);
+	else
+		drain_text(log, head, tail);
+}
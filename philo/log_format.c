@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_format.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:20:16 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 03:20:16 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Write the decimal representation of 'n' to 'dst'.
+ *
+ * @return Number of characters written.
+ */
+static int	put_nbr(char *dst, int64_t n)
+{
+	char	digits[20];
+	int		len;
+	int		i;
+
+	i = 0;
+	len = 0;
+	if (n < 0)
+	{
+		dst[len++] = '-';
+		n = -n;
+	}
+	digits[i++] = '0' + n % 10;
+	while (n >= 10)
+	{
+		n /= 10;
+		digits[i++] = '0' + n % 10;
+	}
+	while (i > 0)
+		dst[len++] = digits[--i];
+	return (len);
+}
+
+/**
+ * Format one record as "<timestamp_in_ms> <id> <message>\n", the same text
+ * the program has always printed. Hand-rolled so the writer never goes
+ * through stdio.
+ *
+ * @return Number of characters written to 'dst'.
+ */
+int	log_format_event(char *dst, const t_event *event)
+{
+	static const char	*state_names[] = {
+		"has taken a fork\n",
+		"is eating\n",
+		"is sleeping\n",
+		"is thinking\n",
+		"died\n",
+	};
+	const char			*name;
+	int					len;
+
+	len = put_nbr(dst, (int)(event->time / 1000));
+	dst[len++] = ' ';
+	len += put_nbr(dst + len, event->id);
+	dst[len++] = ' ';
+	name = state_names[event->state];
+	while (*name)
+		dst[len++] = *name++;
+	return (len);
+}
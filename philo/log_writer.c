@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_writer.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:19:44 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 05:12:33 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Park on 'not_empty' until there is something to format or the log is
+ * closed. Called and returns with 'log->mutex' held.
+ */
+static void	wait_for_records(t_log *log)
+{
+	while (log->head == log->tail && log->closed == false)
+	{
+		log->writer_idle = true;
+		pthread_cond_wait(&log->not_empty, &log->mutex);
+	}
+	log->writer_idle = false;
+}
+
+/**
+ * Writer thread: drain whatever the philosophers produced, then pause for
+ * 'LOG_FLUSH_INTERVAL' so the next batch can accumulate. The pause is
+ * skipped after a batch of half the ring or more, since producers are then
+ * likely to fill it and block before the pause is over. Parks on
+ * 'not_empty' only when the ring is empty, and exits once the log is closed
+ * and fully flushed.
+ *
+ * @param arg Pointer to the 't_log'.
+ * @return NULL.
+ */
+void	*log_writer_main(void *arg)
+{
+	t_log *const	log = (t_log *) arg;
+	uint64_t		head;
+	uint64_t		tail;
+
+	pthread_mutex_lock(&log->mutex);
+	while (log->head != log->tail || log->closed == false)
+	{
+		wait_for_records(log);
+		head = log->head;
+		tail = log->tail;
+		pthread_mutex_unlock(&log->mutex);
+		log_drain(log, head, tail);
+		pthread_mutex_lock(&log->mutex);
+		log->head = tail;
+		pthread_cond_broadcast(&log->not_full);
+		if (log->closed == true || tail - head >= LOG_CAPACITY / 2)
+			continue ;
+		pthread_mutex_unlock(&log->mutex);
+		usleep(LOG_FLUSH_INTERVAL);
+		pthread_mutex_lock(&log->mutex);
+	}
+	pthread_mutex_unlock(&log->mutex);
+	return (NULL);
+}
@@ -6,163 +6,113 @@
 /*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/11/28 00:36:05 by tpirinen          #+#    #+#             */
-/*   Updated: 2026/01/05 15:33:49 by tpirinen         ###   ########.fr       */
+/*   Updated: 2026/10/17 08:32:24 by tpirinen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /**
- * Set the 'start_time' and initial 'last_ate' for each philosopher once all
- * threads have been created. (last_ate is set to the start_time so philosophers
- * don't immediately die of starvation) This arranges for a synchronized
- * start time across threads.
+ * Convert the parsed arguments into timing rules: the shared ones, once for
+ * the whole table, and every philosopher's defaults, see profile_load().
  *
- * @param m Monitor containing philosopher array.
+ * @param r Rules to fill.
+ * @param args Parsed arguments array (milliseconds).
  */
-static void	start_philo_threads(t_monitor *m)
+void	init_rules(t_rules *r, int args[5])
 {
-	int64_t	start_time;
-	int		i;
-
-	if (m->threads_created < m->total_philos)
-		return ;
-	i = 0;
-	start_time = current_time() + THREAD_START_DELAY;
-	pthread_mutex_lock(&m->philo_mutex);
-	while (i < m->total_philos)
-	{
-		m->philos[i].last_ate = start_time;
-		m->philos[i].start_time = start_time;
-		i++;
-	}
-	pthread_mutex_unlock(&m->philo_mutex);
+	r->time_to_die = (int64_t)1000 * args[1];
+	r->time_to_eat = (int64_t)1000 * args[2];
+	r->time_to_sleep = (int64_t)1000 * args[3];
+	r->must_eat = args[4];
 }
 
 /**
- * Initialize mutexes, create philosopher threads and call
- * start_philo_threads() to set philosopher threads in motion.
+ * Initialize the philosophers, their timetable and the forks for the
+ * selected strategy, and the mutex and condition variable the monitor
+ * sleeps on between deadlines. The condition uses the monotonic clock,
+ * like current_time().
  *
- * @param m Monitor to initialize and use for thread creation.
- * @param args Parsed arguments array.
- * @return 0 on success, -1 on pthread create failure.
+ * @param m Monitor to initialize.
  */
-int	start_monitor(t_monitor *m, int args[5])
+static void	init_table(t_monitor *m)
 {
-	int		i;
-	t_philo	*philo;
+	pthread_condattr_t	attr;
+	int					i;
 
-	i = 0;
-	m->total_philos = args[0];
-	while (i < m->total_philos)
-		pthread_mutex_init(&m->forks[i++], NULL);
-	pthread_mutex_init(&m->philo_mutex, NULL);
 	i = 0;
 	while (i < m->total_philos)
 	{
-		philo = &m->philos[i];
-		philo_init(philo, m, i, args);
-		if (pthread_create(&philo->thread, NULL, philo_main, philo) > 0)
-		{
-			printf("error: pthread_create failure");
-			return (-1);
-		}
-		m->threads_created++;
+		philo_init(&m->philos[i], m, i);
 		i++;
 	}
-	start_philo_threads(m);
-	return (0);
+	plan_build(m);
+	strategy_init(m);
+	pthread_mutex_init(&m->wake_mutex, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&m->wake_cond, &attr);
+	pthread_condattr_destroy(&attr);
 }
 
 /**
- * Inspect all philosophers to detect whether the simulation should end due
- * to a death or all philosophers having eaten the required number of times.
+ * Initialize mutexes, start the log writer and hand the table to the
+ * selected engine, which sets the philosophers in motion, then start
+ * updating the '-L' file. The calling thread goes on as the monitor,
+ * placed by affinity_monitor().
  *
- * @param m Monitor containing philosophers.
- * @param dead_idx Out parameter set to index of dead philosopher (if any).
- * @param must_eat_reached Counter incremented when a philosopher reaches
- * the wanted amount of meals.
- * @return 'EXIT_MONITOR' when simulation must stop, 'CONTINUE_MONITOR'
- * otherwise.
+ * @param m Monitor to initialize.
+ * @param args Parsed arguments array.
+ * @return 0 on success, -1 if the trace, the '-L' file, the log, the
+ * histograms or the engine failed to start.
  */
-static int	scan_philos(t_monitor *m, int *dead_idx, int *must_eat_reached)
+int	start_monitor(t_monitor *m, int args[5])
 {
-	int		i;
-	int64_t	now;
-
-	i = 0;
-	now = current_time();
-	while (i < m->total_philos)
-	{
-		if (m->philos[i].stop_simulation == true)
-			return (EXIT_MONITOR);
-		if (m->philos[i].has_eaten == m->philos[i].must_eat)
-			(*must_eat_reached)++;
-		else if (m->philos[i].last_ate + m->philos[i].time_to_die <= now)
-		{
-			m->philos[i].stop_simulation = true;
-			*dead_idx = i;
-			return (EXIT_MONITOR);
-		}
-		i++;
-	}
-	return (CONTINUE_MONITOR);
+	m->total_philos = args[0];
+	init_rules(&m->rules, args);
+	init_table(m);
+	if (trace_open(m) == -1 || live_open(m) == -1
+		|| log_start(&m->log) == -1 || stats_start(m) == -1)
+		return (-1);
+	affinity_save(m);
+	if (m->opts.engine->start(m) == -1 || live_start(m) == -1)
+		return (-1);
+	affinity_monitor(m, 0);
+	return (0);
 }
 
 /**
- * Main monitor loop: periodically scans philosophers for death or completion.
- * Stops when philosopher scan returns 'EXIT_MONITOR'.
- * 'dead_idx' is set to -1 as to not signify a specific philosopher.
- * 'dead_idx' gets set to the index of the dead philosopher in 'scan_philos'.
+ * Raises the stop flag, wakes every sleeper, stops the '-L' updates and the
+ * engine, prints the run summary and the histograms if asked to, publishes
+ * the final '-L' figures, destroys mutexes and flushes the log once no
+ * philosopher can produce more events.
  *
- * @param m Monitor structure managing philosophers.
+ * @param m Monitor to stop and clean up.
+ * @return 0 on success, -1 if the '-J' file could not be written.
  */
-void	loop_monitor(t_monitor *m)
+int	stop_monitor(t_monitor *m)
 {
-	int		i;
-	int		dead_idx;
-	int		must_eat_reached;
+	int	status;
 
-	must_eat_reached = 0;
-	while (must_eat_reached < m->total_philos)
+	status = 0;
+	set_stop_simulation(m);
+	stop_broadcast(m);
+	live_stop(m);
+	m->opts.engine->stop(m);
+	m->stop_latency = current_time()
+		- atomic_load_explicit(&m->stop_time, memory_order_relaxed);
+	affinity_restore(m);
+	if (atomic_load_explicit(&m->start_time, memory_order_relaxed) != 0)
 	{
-		dead_idx = -1;
-		must_eat_reached = 0;
-		pthread_mutex_lock(&m->philo_mutex);
-		if (scan_philos(m, &dead_idx, &must_eat_reached) == EXIT_MONITOR)
-		{
-			i = 0;
-			while (i < m->threads_created)
-				m->philos[i++].stop_simulation = true;
-			pthread_mutex_unlock(&m->philo_mutex);
-			if (dead_idx != -1)
-				philo_print(&m->philos[dead_idx], DEAD);
-			return ;
-		}
-		pthread_mutex_unlock(&m->philo_mutex);
-		usleep(MONITOR_RUNNING_RATE);
+		m->end_time = sim_time(m);
+		if (m->opts.report)
+			report_print(m);
+		status = stats_report(m);
 	}
-}
-
-/**
- * Joins the philo threads and destroys mutexes.
- *
- * @param m Monitor to stop and clean up.
- */
-void	stop_monitor(t_monitor *m)
-{
-	int	i;
-
-	i = 0;
-	pthread_mutex_lock(&m->philo_mutex);
-	while (i < m->threads_created)
-		m->philos[i++].stop_simulation = true;
-	pthread_mutex_unlock(&m->philo_mutex);
-	i = 0;
-	while (i < m->threads_created)
-		pthread_join(m->philos[i++].thread, NULL);
-	i = 0;
-	while (i < m->total_philos)
-		pthread_mutex_destroy(&m->forks[i++]);
-	pthread_mutex_destroy(&m->philo_mutex);
+	live_close(m);
+	strategy_destroy(m);
+	pthread_cond_destroy(&m->wake_cond);
+	pthread_mutex_destroy(&m->wake_mutex);
+	log_close(&m->log);
+	return (status);
 }
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_loop.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:27:40 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:09:09 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return true once the monitor has nothing left to watch.
+ */
+static bool	monitor_done(t_monitor *m)
+{
+	return (atomic_load_explicit(&m->stop_simulation, memory_order_acquire)
+		|| atomic_load_explicit(&m->full_philos, memory_order_acquire)
+		>= m->total_philos);
+}
+
+/**
+ * Sleep until 'deadline', or until a philosopher signals that everyone is
+ * full. The check of monitor_done() under 'wake_mutex' pairs with
+ * monitor_notify_full() so the wakeup cannot be lost.
+ *
+ * The sleep is capped at 'MONITOR_MAX_SLEEP'. On a saturated run queue a
+ * thread returning from one long sleep was measured to be scheduled tens of
+ * milliseconds late, while a monitor that checks in every millisecond stays
+ * responsive; each extra wakeup only peeks at the top of the heap.
+ *
+ * @param m Monitor waiting.
+ * @param deadline Absolute time in microseconds.
+ * @param now Current time in microseconds.
+ */
+static void	wait_for_deadline(t_monitor *m, int64_t deadline, int64_t now)
+{
+	struct timespec	ts;
+
+	if (deadline > now + MONITOR_MAX_SLEEP)
+		deadline = now + MONITOR_MAX_SLEEP;
+	ts.tv_sec = deadline / 1000000;
+	ts.tv_nsec = (deadline % 1000000) * 1000;
+	pthread_mutex_lock(&m->wake_mutex);
+	if (monitor_done(m) == false)
+		pthread_cond_timedwait(&m->wake_cond, &m->wake_mutex, &ts);
+	pthread_mutex_unlock(&m->wake_mutex);
+}
+
+/**
+ * The earliest deadline in the shard's heap has passed. Re-read the
+ * philosopher it belongs to: if it ate since the deadline was recorded, or
+ * is full, move its key and restore the heap; otherwise it has starved.
+ * The philosopher's state is read with atomic loads and never waits.
+ *
+ * @param s Shard owning the heap.
+ * @param now Current time in microseconds.
+ * @return 'EXIT_MONITOR' if the philosopher at the top of the heap is dead,
+ * 'CONTINUE_MONITOR' otherwise.
+ */
+static int	check_earliest(t_shard *s, int64_t now)
+{
+	t_monitor *const	m = s->monitor;
+	t_deadline *const	top = &s->heap[0];
+	t_philo *const		p = &m->philos[top->idx];
+	int64_t				deadline;
+
+	deadline = get_last_ate(p) + p->rules.time_to_die;
+	if (get_has_eaten(p) == p->rules.must_eat)
+		top->deadline = INT64_MAX;
+	else if (deadline > now)
+		top->deadline = deadline;
+	else
+	{
+		top->deadline = deadline;
+		return (EXIT_MONITOR);
+	}
+	heap_sift_down(s->heap, s->count, 0);
+	return (CONTINUE_MONITOR);
+}
+
+/**
+ * Watch the deadlines of a shard's philosophers in a min-heap and sleep
+ * until the earliest one, so the work per wakeup is O(log N) instead of a
+ * scan of the range. Deadlines are re-keyed lazily when they come due,
+ * which means philosophers never have to touch the heap. Returns on a
+ * death, when everyone is full, or when the simulation is stopped. Of the
+ * shards seeing a death, set_stop_simulation() lets one print it, and
+ * that one wakes the others.
+ *
+ * @param s Shard to run, from its own thread.
+ */
+void	shard_watch(t_shard *s)
+{
+	t_monitor *const	m = s->monitor;
+	int64_t				now;
+
+	heap_build(m, s->heap, s->count);
+	while (monitor_done(m) == false)
+	{
+		now = current_time();
+		if (s->heap[0].deadline > now)
+			wait_for_deadline(m, s->heap[0].deadline, now);
+		else if (check_earliest(s, now) == EXIT_MONITOR)
+		{
+			if (set_stop_simulation(m))
+			{
+				m->detect_latency = current_time() - s->heap[0].deadline;
+				philo_print(&m->philos[s->heap[0].idx], DEAD);
+				monitor_wake(m);
+			}
+			return ;
+		}
+	}
+}
+
+/**
+ * Wake every shard sleeping in wait_for_deadline(), so they see the run is
+ * over without waiting out their sleep.
+ *
+ * @param m Monitor to wake.
+ */
+void	monitor_wake(t_monitor *m)
+{
+	pthread_mutex_lock(&m->wake_mutex);
+	pthread_cond_broadcast(&m->wake_cond);
+	pthread_mutex_unlock(&m->wake_mutex);
+}
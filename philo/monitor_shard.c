@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_shard.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:04:01 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:22:31 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * How many monitor threads watch the table: as many as '-m' asks for, or
+ * enough for 'SHARD_PHILOS' philosophers each, at most one per online CPU.
+ * Never more than there are philosophers, and one on the virtual clock of
+ * 'des', which checks deaths itself.
+ *
+ * @param m Monitor with 'total_philos' and the options set.
+ * @return Number of shards, at least 1.
+ */
+int	monitor_shards(t_monitor *m)
+{
+	long	count;
+	long	cpus;
+
+	count = m->opts.shards;
+	if (count == 0)
+	{
+		count = (m->total_philos + SHARD_PHILOS - 1) / SHARD_PHILOS;
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		if (count > cpus)
+			count = cpus;
+	}
+	if (count > m->total_philos)
+		count = m->total_philos;
+	if (count < 1 || m->opts.engine->virtual_clock)
+		count = 1;
+	return (count);
+}
+
+/**
+ * Thread of a shard other than 0: placed like the monitor, see
+ * affinity_monitor(), then watches its range until the run is over.
+ */
+static void	*shard_main(void *arg)
+{
+	t_shard *const	s = arg;
+
+	affinity_monitor(s->monitor, s->index);
+	shard_watch(s);
+	return (NULL);
+}
+
+/**
+ * Split the philosophers into 'shard_count' contiguous ranges and start a
+ * thread for every shard but 0, which takes the last range. If a thread
+ * cannot be created, shard 0 takes its range and those of the shards
+ * after it instead, and 'shard_count' is lowered to the shards running.
+ *
+ * @param m Monitor with (shards) allocated.
+ */
+static void	shard_spawn(t_monitor *m)
+{
+	const int	per_shard = m->total_philos / m->shard_count;
+	t_shard		*s;
+	int			first;
+	int			i;
+
+	first = 0;
+	i = 1;
+	while (i < m->shard_count)
+	{
+		s = &m->shards[i];
+		*s = (t_shard){m, m->deadlines + first, per_shard, i, 0};
+		if (pthread_create(&s->thread, NULL, shard_main, s) != 0)
+			break ;
+		first += per_shard;
+		i++;
+	}
+	m->shard_count = i;
+	m->shards[0] = (t_shard){m, m->deadlines + first,
+		m->total_philos - first, 0, 0};
+}
+
+/**
+ * Run the monitor until a philosopher dies, everyone is full or the
+ * simulation is stopped: the calling thread watches shard 0 while the
+ * others run on their own threads, see shard_watch(), so a large table is
+ * watched in parallel and detecting a death does not wait on one thread
+ * walking every deadline. Returns once every shard has.
+ *
+ * @param m Monitor structure managing philosophers.
+ */
+void	loop_monitor(t_monitor *m)
+{
+	int	i;
+
+	shard_spawn(m);
+	shard_watch(&m->shards[0]);
+	i = 1;
+	while (i < m->shard_count)
+		pthread_join(m->shards[i++].thread, NULL);
+}
+
+/**
+ * Called by a philosopher that has reached 'must_eat'. The last one to do
+ * so wakes the monitor so the simulation ends without waiting out the
+ * monitor's current sleep. In a child of the 'procs' engine the count is
+ * kept by the parent, see relay_full().
+ *
+ * @param m Monitor to notify.
+ */
+void	monitor_notify_full(t_monitor *m)
+{
+	if (m->procs.child)
+	{
+		relay_full(m);
+		return ;
+	}
+	if (atomic_fetch_add_explicit(&m->full_philos, 1, memory_order_acq_rel)
+		+ 1 < m->total_philos)
+		return ;
+	monitor_wake(m);
+}
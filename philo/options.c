@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:51:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:56:53 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return true if 'arg' looks like a flag ("-x"), as opposed to a number.
+ */
+static bool	is_flag(const char *arg)
+{
+	return (arg[0] == '-' && ((arg[1] >= 'a' && arg[1] <= 'z')
+			|| (arg[1] >= 'A' && arg[1] <= 'Z')) && arg[2] == '\0');
+}
+
+/**
+ * The options that only change what a run outputs, see find_option().
+ *
+ * @return The table, ended by an entry with flag '\0'.
+ */
+static const t_option	*output_options(void)
+{
+	static const t_option	table[] = {
+	{'r', false, set_report},
+	{'H', false, set_stats},
+	{'J', true, set_stats_file},
+	{'t', true, set_trace},
+	{'b', true, set_batch},
+	{'L', true, set_live},
+	{'\0', false, NULL},
+	};
+
+	return (table);
+}
+
+/**
+ * Look 'flag' up in the tables of the options parse_options() accepts:
+ * those of how the run goes, then output_options().
+ *
+ * @return The table entry for 'flag', the end of the table (with no 'set')
+ * if the flag is unknown.
+ */
+static const t_option	*find_option(char flag)
+{
+	static const t_option	table[] = {
+	{'s', true, set_strategy},
+	{'e', true, set_engine},
+	{'j', true, set_workers},
+	{'d', true, set_seed},
+	{'w', false, set_wheel},
+	{'a', true, set_affinity},
+	{'F', false, set_fifo},
+	{'S', true, set_stack},
+	{'p', true, set_policy},
+	{'m', true, set_shards},
+	{'g', true, set_topology},
+	{'P', true, set_profile},
+	{'\0', false, NULL},
+	};
+	const t_option			*option;
+
+	option = table;
+	while (option->flag != '\0' && option->flag != flag)
+		option++;
+	if (option->flag == '\0')
+		option = output_options();
+	while (option->flag != '\0' && option->flag != flag)
+		option++;
+	return (option);
+}
+
+/**
+ * Defaults for the options not given: the 'ordered' strategy, the 'threads'
+ * engine, the 'adaptive' think policy, and as many 'pool' workers as there
+ * are online CPUs.
+ *
+ * @param opts Options to reset.
+ */
+void	options_defaults(t_options *opts)
+{
+	opts->strategy = strategy_find("ordered");
+	opts->engine = engine_find("threads");
+	opts->policy = policy_find("adaptive");
+	opts->workers = sysconf(_SC_NPROCESSORS_ONLN);
+	if (opts->workers < 1)
+		opts->workers = 1;
+}
+
+/**
+ * Parse the flags given before the positional arguments:
+ *  -s <ordered|chandy|waiter|trylock|ticket>  fork-acquisition strategy
+ *  -e <threads|pool|des|procs>                how philosophers are run
+ *  -j <workers>                               'pool' threads, 'procs' children
+ *  -d <seed>                                  tie-breaking seed for 'des'
+ *  -w                                         'threads' wait on a timer wheel
+ *  -r                                         print a run summary to stderr
+ *  -H                                         print latency histograms
+ *  -J <file>                                  write them to 'file' as JSON
+ *  -t <file>                                  binary trace instead of text
+ *  -b <file>                                  run a batch of configurations
+ *  -L <file>                                  live stats for philo_top
+ *  -a <rr|block>                              pin threads to CPUs
+ *  -F                                         SCHED_FIFO philos and monitor
+ *  -S <KiB>                                   philosopher thread stacks
+ *  -p <fixed|adaptive|planned>                when to reach for the forks
+ *  -m <shards>                                monitor threads, 0 for auto
+ *  -g <ring|grid|complete|regular:k|file>     which forks a meal takes
+ *  -P <file>                                  per-philosopher timings
+ * The 'pool', 'des' and 'procs' engines always take forks in resource
+ * order, so '-s' only applies to 'threads'; '-w' does not apply to 'procs'.
+ * On a topology other than a ring, every engine takes them in resource
+ * order, see topology_build().
+ * Parsing stops at the first argument that is not a flag, so negative
+ * numbers are left for parse_args() to reject.
+ *
+ * @param opts Options to fill, see options_defaults().
+ * @return Index of the first positional argument, -1 on invalid options.
+ */
+int	parse_options(int ac, char **av, t_options *opts)
+{
+	const t_option	*option;
+	int				i;
+
+	options_defaults(opts);
+	i = 1;
+	while (i < ac && is_flag(av[i]))
+	{
+		option = find_option(av[i][1]);
+		if (option->set == NULL || (option->has_value && ++i >= ac)
+			|| option->set(opts, av[i]) == -1)
+			return (-1);
+		i++;
+	}
+	return (i);
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_flags.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:41:14 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 05:07:37 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * '-r': print a summary of the run to stderr when it ends.
+ */
+int	set_report(t_options *opts, const char *value)
+{
+	(void)value;
+	opts->report = true;
+	return (0);
+}
+
+/**
+ * '-w': philosopher threads wait on the shared timer service.
+ */
+int	set_wheel(t_options *opts, const char *value)
+{
+	(void)value;
+	opts->wheel = true;
+	return (0);
+}
+
+/**
+ * '-H': print latency histograms to stderr when the run ends.
+ */
+int	set_stats(t_options *opts, const char *value)
+{
+	(void)value;
+	opts->stats = true;
+	opts->histograms = true;
+	return (0);
+}
+
+/**
+ * '-J <file>': write the latency histograms to 'file' as JSON.
+ */
+int	set_stats_file(t_options *opts, const char *value)
+{
+	opts->stats_file = value;
+	opts->histograms = true;
+	return (0);
+}
+
+/**
+ * '-t <file>': log to 'file' as a binary trace instead of text on stdout.
+ */
+int	set_trace(t_options *opts, const char *value)
+{
+	opts->trace_file = value;
+	return (0);
+}
@@ -0,0 +1,40 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_monitor.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:04:01 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:56:53 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * '-m <shards>': number of monitor threads watching the deadlines, see
+ * monitor_shards(). 0 sizes them to the table and the CPUs, the default.
+ */
+int	set_shards(t_options *opts, const char *value)
+{
+	int	shards;
+
+	shards = parse_nbr(value);
+	if (value[0] < '0' || value[0] > '9' || shards < 0)
+		return (-1);
+	opts->shards = shards;
+	return (0);
+}
+
+/**
+ * '-L <file>': keep live stats in 'file' for philo_top while the run goes
+ * on, see live_open().
+ */
+int	set_live(t_options *opts, const char *value)
+{
+	if (value[0] == '\0')
+		return (-1);
+	opts->live_file = value;
+	return (0);
+}
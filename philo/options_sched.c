@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_sched.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:32:00 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:51:16 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * '-a <rr|block>': pin each philosopher thread to a CPU, dealt out one CPU
+ * at a time ('rr') or in runs of neighbours ('block'), and the monitor to
+ * a CPU of its own, see affinity_place(). With 'pool' the workers are
+ * placed instead; 'des' runs on one thread and ignores it.
+ */
+int	set_affinity(t_options *opts, const char *value)
+{
+	if (strcmp(value, "rr") == 0)
+		opts->affinity = AFFINITY_RR;
+	else if (strcmp(value, "block") == 0)
+		opts->affinity = AFFINITY_BLOCK;
+	else
+		return (-1);
+	return (0);
+}
+
+/**
+ * '-F': run the philosophers and the monitor as SCHED_FIFO threads, the
+ * monitor one priority above. Falls back to the default policy, with a
+ * warning, when the process may not use it.
+ */
+int	set_fifo(t_options *opts, const char *value)
+{
+	(void)value;
+	opts->fifo = true;
+	return (0);
+}
+
+/**
+ * '-S <KiB>': stack size of the philosopher threads of 'threads', rounded
+ * up to whole pages, see spawn_stacks(). The default is the system's,
+ * usually 8 MiB of address space per thread.
+ */
+int	set_stack(t_options *opts, const char *value)
+{
+	const size_t	page = sysconf(_SC_PAGESIZE);
+	int				kib;
+
+	kib = parse_nbr(value);
+	if (kib <= 0 || (long)kib * 1024 < (long)PTHREAD_STACK_MIN)
+		return (-1);
+	opts->stack_size = ((size_t)kib * 1024 + page - 1) / page * page;
+	return (0);
+}
+
+/**
+ * '-p <fixed|adaptive|planned>': when philosophers reach for their forks,
+ * see policy_find().
+ */
+int	set_policy(t_options *opts, const char *value)
+{
+	opts->policy = policy_find(value);
+	opts->policy_given = true;
+	if (opts->policy == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * '-g <ring|grid|complete|regular:k|file>': which forks every philosopher
+ * eats with, see topology_build(). Generators are checked against the
+ * table once its size is known.
+ */
+int	set_topology(t_options *opts, const char *value)
+{
+	if (value[0] == '\0')
+		return (-1);
+	opts->topology = value;
+	return (0);
+}
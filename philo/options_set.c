@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_set.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:22:31 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * '-s <name>': select the fork-acquisition strategy.
+ */
+int	set_strategy(t_options *opts, const char *value)
+{
+	opts->strategy = strategy_find(value);
+	if (opts->strategy == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * '-e <name>': select how the philosophers are run.
+ */
+int	set_engine(t_options *opts, const char *value)
+{
+	opts->engine = engine_find(value);
+	if (opts->engine == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * '-j <workers>': number of worker threads of the 'pool' engine, or of
+ * child processes of the 'procs' engine.
+ */
+int	set_workers(t_options *opts, const char *value)
+{
+	opts->workers = parse_nbr(value);
+	if (opts->workers <= 0)
+		return (-1);
+	return (0);
+}
+
+/**
+ * '-d <seed>': seed for the 'des' engine.
+ */
+int	set_seed(t_options *opts, const char *value)
+{
+	int	seed;
+
+	seed = parse_nbr(value);
+	if (value[0] == '\0' || seed < 0)
+		return (-1);
+	opts->seed = seed;
+	return (0);
+}
+
+/**
+ * '-b <file>': run every configuration of 'file' instead of the positional
+ * arguments, see batch_run().
+ */
+int	set_batch(t_options *opts, const char *value)
+{
+	opts->batch_file = value;
+	return (0);
+}
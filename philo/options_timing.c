@@ -0,0 +1,25 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_timing.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:39:35 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:39:35 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * '-P <file>': per-philosopher timings, read once the table is allocated,
+ * see profile_load().
+ */
+int	set_profile(t_options *opts, const char *value)
+{
+	if (value[0] == '\0')
+		return (-1);
+	opts->profile = value;
+	return (0);
+}
@@ -0,0 +1,37 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parse.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:36:04 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:36:04 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Parse a positive integer from a string. Non-digits are ignored.
+ * Handles overflow of 'INT_MAX'.
+ *
+ * @param s Input string containing decimal digits.
+ * @return Parsed integer value, -1 if overflows INT_MAX.
+ */
+int	parse_nbr(const char *s)
+{
+	long long	n;
+
+	n = 0;
+	while ('0' <= *s && *s <= '9')
+	{
+		n = n * 10 + (*s - '0');
+		if (n > INT_MAX)
+			return (-1);
+		s++;
+		if (*s && (*s < '0' || *s > '9'))
+			return (-1);
+	}
+	return ((int)n);
+}
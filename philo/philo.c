@@ -6,95 +6,57 @@
 /*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/11/28 00:36:09 by tpirinen          #+#    #+#             */
-/*   Updated: 2026/01/05 15:34:44 by tpirinen         ###   ########.fr       */
+/*   Updated: 2026/10/17 08:51:16 by tpirinen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /**
- * Initialize a 't_philo' structure with parameters from the
- * 'args' array and monitor. Sets fork pointers, time values, and initial flags.
+ * Initialize a 't_philo' structure: sets its id, its row of the topology,
+ * the fork pointers of a ring and its slot in the monitor's hot state
+ * array. A philosopher with fewer than two forks, on any topology, is
+ * lone: it can never eat. Its rules were set beforehand, see
+ * profile_load().
  *
  * @param p Philosopher to initialize.
  * @param m Monitor owning the forks.
  * @param index Zero-based philosopher index.
- * @param args Array of parsed arguments.
  */
-void	philo_init(t_philo *p, t_monitor *m, int index, int args[5])
+void	philo_init(t_philo *p, t_monitor *m, int index)
 {
 	p->monitor = m;
 	p->id = index + 1;
-	p->time_to_die = (int64_t)1000 * args[1];
-	p->time_to_eat = (int64_t)1000 * args[2];
-	p->time_to_sleep = (int64_t)1000 * args[3];
-	p->must_eat = args[4];
-	if (m->total_philos == 1)
-	{
-		p->fork1 = &m->forks[0];
-		p->fork2 = NULL;
-	}
-	else
-	{
+	p->state = &m->states[index];
+	p->needs = &m->topology.needs[m->topology.offsets[index]];
+	p->need_count = m->topology.offsets[index + 1]
+		- m->topology.offsets[index];
+	p->lone = (p->need_count < 2);
+	p->fork1 = NULL;
+	p->fork2 = NULL;
+	if (m->topology.ring)
 		p->fork1 = &m->forks[index];
+	if (m->topology.ring && p->lone == false)
 		p->fork2 = &m->forks[(index + 1) % m->total_philos];
-	}
 }
 
 /**
- * Special-case lifecycle for the single philosopher scenario: lock the only
- * fork, wait until death, print events and stop the simulation.
+ * Special-case lifecycle for the single philosopher scenario: lock the
+ * fork it has, if any, wait until death, print events and stop the
+ * simulation.
  *
- * @param p Philosopher (with 'fork2 == NULL').
+ * @param p Philosopher (with 'lone' set).
  * @return NULL pointer (thread exit value).
  */
 static void	*handle_single_philo(t_philo *p)
 {
-	pthread_mutex_lock(p->fork1);
-	philo_print(p, TOOK_FORK);
-	wait_for(p, p->time_to_die);
-	pthread_mutex_unlock(p->fork1);
+	ordered_take(p);
+	wait_for(p, p->rules.time_to_die);
+	ordered_put(p);
 	philo_print(p, DEAD);
 	return (NULL);
 }
 
-/**
- * Function to retain the stagger set with stagger_starting_times().
- * Philosophers think for at least 'min_time_to_think' amount of time;
- * unless time left before the philosopher must eat to avoid dying is less than
- * the minimum.
- * 
- * When total_philos == even || min is set to 25% of slack
- * When total_philos == odd  || min is set to 75% of slack
- * 
- * @param p Philosopher thinking.
- */
-static void	thinking(t_philo *p)
-{
-	int64_t	slack;
-	int64_t	min_time_to_think;
-	int64_t	time_left;
-	int64_t	time_to_think;
-
-	slack = p->time_to_die - p->time_to_eat - p->time_to_sleep;
-	if (slack <= 0)
-		return ;
-	min_time_to_think = slack / 4;
-	if (p->monitor->total_philos % 2 != 0)
-		min_time_to_think = slack - (slack / 4);
-	pthread_mutex_lock(&p->monitor->philo_mutex);
-	time_left = p->time_to_die
-		- (current_time() - p->last_ate)
-		- p->time_to_eat;
-	pthread_mutex_unlock(&p->monitor->philo_mutex);
-	if (time_left <= 0)
-		return ;
-	time_to_think = min_time_to_think;
-	if (time_to_think > time_left)
-		time_to_think = time_left;
-	wait_for(p, time_to_think);
-}
-
 /**
  * Thread entry point and main loop for a philosopher thread.
  * Waits for the global start time, enters the 
@@ -108,52 +70,41 @@ void	*philo_main(void *arg)
 {
 	t_philo *const	p = (t_philo*) arg;
 
+	affinity_place(p->monitor, p->id - 1, p->monitor->total_philos);
 	wait_for_start_time(p);
-	if (p->fork2 == NULL)
+	if (p->lone)
 		return (handle_single_philo(p));
 	stagger_starting_times(p);
 	while (get_stop_simulation(p) == false)
 	{
 		philo_print(p, THINKING);
-		if (p->has_eaten != 0)
-			thinking(p);
+		if (get_has_eaten(p) != 0)
+			wait_for(p, p->monitor->opts.policy->think(p, current_time()));
 		take_forks(p);
 		if (eat_and_check_saturation(p) == FULL)
 			return (NULL);
 		philo_print(p, SLEEPING);
-		wait_for(p, p->time_to_sleep);
+		wait_for(p, prng_duration(&p->rng, &p->sleep));
 	}
 	return (NULL);
 }
 
 /**
- * Prints a timestamped state message for a philosopher.
- * Uses 'philo_mutex' to guard 'death_printed' in the monitor
- * structure so that no messages are printed after a death message.
+ * Records a timestamped state message for a philosopher. The message is
+ * queued on the monitor's log and printed by the writer thread, which
+ * guarantees that no messages are printed after a death message. The
+ * state and the count of events are kept for '-L' with relaxed stores,
+ * two writes to the philosopher's own cache line.
  *
  * @param p Philosopher whose state is printed.
  * @param state State enumerator indicating which message to print.
  */
 void	philo_print(t_philo *p, enum e_state state)
 {
-	int					timestamp;
-	static char *const	state_names[] = {
-		"has taken a fork",
-		"is eating",
-		"is sleeping",
-		"is thinking",
-		"died",
-	};
+	t_philo_state *const	s = p->state;
 
-	pthread_mutex_lock(&p->monitor->philo_mutex);
-	if (p->monitor->death_printed == true)
-	{
-		pthread_mutex_unlock(&p->monitor->philo_mutex);
-		return ;
-	}
-	if (state == DEAD)
-		p->monitor->death_printed = true;
-	timestamp = (current_time() - p->start_time) / 1000;
-	printf("%d %d %s\n", timestamp, p->id, state_names[state]);
-	pthread_mutex_unlock(&p->monitor->philo_mutex);
+	atomic_store_explicit(&s->doing, state, memory_order_relaxed);
+	atomic_store_explicit(&s->events, atomic_load_explicit(&s->events,
+			memory_order_relaxed) + 1, memory_order_relaxed);
+	log_push(p->monitor, p->id, state);
 }
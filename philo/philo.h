@@ -6,7 +6,7 @@
 /*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/11/28 00:36:36 by tpirinen          #+#    #+#             */
-/*   Updated: 2026/01/05 15:35:27 by tpirinen         ###   ########.fr       */
+/*   Updated: 2026/10/17 08:57:39 by tpirinen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,30 +15,674 @@
 
 // Included libraries	// What is being used from the library
 # include <pthread.h>	//	- thread and mutex control functions
-# include <sys/time.h>	//	- gettimeofday()
-# include <unistd.h>	//	- usleep()
+# include <time.h>		//	- clock_gettime()
+# include <sched.h>		//	- sched_yield(), cpu_set_t
+# include <unistd.h>	//	- usleep(), write()
 # include <stdlib.h>	//	- malloc() and free()
 # include <stdint.h>	//	- INT64_MAX
 # include <stdio.h>		//	- printf()
 # include <stdbool.h>	//	- type bool, true and false
 # include <string.h>	//	- memset()
 # include <limits.h>	//	- INT_MAX
+# include <errno.h>		//	- EINTR
+# include <stdatomic.h>	//	- atomic loads and stores on shared state
+# include <stdalign.h>	//	- alignas()
+# include <sys/resource.h>	//	- getrusage()
+# include <semaphore.h>	//	- sem_wait(), sem_post()
+# include <fcntl.h>		//	- open()
+# include <sys/syscall.h>	//	- SYS_futex
+# include <linux/futex.h>	//	- FUTEX_WAIT_BITSET, FUTEX_WAKE
+# include <sys/mman.h>	//	- mmap() of the '-S' stacks and of 'procs'
+# include <sys/wait.h>	//	- waitpid()
+# include "libphilo.h"	//	- public API, t_event and enum e_state
 
-# define MONITOR_RUNNING_RATE 100		// (microseconds)
+# define CACHE_LINE 64					// (bytes)
+# define MONITOR_MAX_SLEEP 1000			// (microseconds)
+# define SHARD_PHILOS 1024				// philos per monitor shard, at most
 # define THREAD_START_DELAY 10000		// (microseconds)
+# define GATE_MARGIN 10000				// (microseconds) gate to start_time
+# define GATE_MARGIN_PER_PHILO 10		// (microseconds) to wake each one
+# define GATE_OPEN 1					// (gate) bits
+# define GATE_STOPPED 2
+# define SPAWN_SLICE 64					// philos per spawner thread, at least
 # define THINK_DELAY 100				// (microseconds)
-# define WAIT_SEGMENT 100				// (microseconds)
+# define THINK_MARGIN 1000				// (microseconds) see adaptive_think()
+# define SPIN_THRESHOLD 100				// (microseconds)
+# define LOG_CAPACITY 4096				// event records, power of two
+# define LOG_BUFFER_SIZE 65536			// bytes formatted per write()
+# define LOG_FLUSH_INTERVAL 1000		// (microseconds)
+# define BACKOFF_MIN 50					// (microseconds)
+# define BACKOFF_MAX 1000				// (microseconds)
+# define WHEEL_TICK 10					// (microseconds)
+# define WHEEL_BITS 8					// log2 of the slots per level
+# define WHEEL_SIZE 256					// slots per level
+# define WHEEL_MASK 255					// WHEEL_SIZE - 1
+# define WHEEL_LEVELS 4
+# define WHEEL_TOP_SHIFT 24				// WHEEL_BITS * (WHEEL_LEVELS - 1)
+# define STEP_PARKED -1					// philo_step(): waiting for a fork
+# define STEP_DONE -2					// philo_step(): full or stopped
+# define HIST_SUB_BITS 4					// log2 of the buckets per doubling
+# define HIST_SUB_COUNT 16				// 1 << HIST_SUB_BITS
+# define HIST_MAX_BITS 32				// larger values share the last bucket
+# define HIST_BUCKETS 464				// (HIST_MAX_BITS - 3) * HIST_SUB_COUNT
+# define STAT_KINDS 4					// measurements in enum e_stat
+# define TRACE_MAGIC 0x52544850			// "PHTR" in a little-endian file
+# define TRACE_VERSION 3				// 3: then every philosopher's rules
+# define BATCH_PATH_MAX 4096				// bytes of a run's log path
+# define RELAY_BATCH 256					// events moved per relay lock
+# define REGULAR_SWAPS 10				// edge swaps per edge
+# define COMPLETE_MAX 1024				// philos of '-g complete', at most
+# define RESOURCE_MAX 1048576			// resource ids of a '-g' file, below
+# define LIVE_MAGIC 0x564C4850			// "PHLV" in a little-endian file
+# define LIVE_VERSION 1
+# define LIVE_INTERVAL 100000			// (microseconds) between updates
 
 typedef struct s_philo		t_philo;
 typedef struct s_monitor	t_monitor;
+typedef struct s_rules		t_rules;
+typedef struct s_fork		t_fork;
+typedef struct s_philo_state	t_philo_state;
+typedef struct s_strategy	t_strategy;
+typedef struct s_options	t_options;
+typedef struct s_waiter		t_waiter;
+typedef struct s_option		t_option;
+typedef struct s_summary	t_summary;
+typedef struct s_event		t_event;
+typedef struct s_deadline	t_deadline;
+typedef struct s_log		t_log;
+typedef struct s_engine		t_engine;
+typedef struct s_timer		t_timer;
+typedef struct s_wheel		t_wheel;
+typedef struct s_runq		t_runq;
+typedef struct s_pool		t_pool;
+typedef struct s_timers		t_timers;
+typedef struct s_des_event	t_des_event;
+typedef struct s_des		t_des;
+typedef struct s_hist		t_hist;
+typedef struct s_stats		t_stats;
+typedef struct s_trace_header	t_trace_header;
+typedef struct s_batch		t_batch;
+typedef struct s_batch_run	t_batch_run;
+typedef struct s_affinity	t_affinity;
+typedef struct s_policy		t_policy;
+typedef struct s_shard		t_shard;
+typedef struct s_shared		t_shared;
+typedef struct s_procs		t_procs;
+typedef struct s_topology	t_topology;
+typedef struct s_regular	t_regular;
+typedef struct s_duration	t_duration;
+typedef struct s_trace_rules	t_trace_rules;
+typedef struct s_live_header	t_live_header;
+typedef struct s_live_philo	t_live_philo;
+typedef struct s_live		t_live;
+
+/**
+ * '-t': start of a binary trace, followed by the topology, 'philos' + 1
+ * row offsets then 'needs' resources as in 't_topology' (as int32_t, padded
+ * to 8 bytes), then by one 't_trace_rules' per philosopher, and by raw
+ * 't_event' records in the order they were logged. The timings here are
+ * those of the command line, '-P' can change them per philosopher.
+ */
+struct s_trace_header
+{
+	uint32_t			magic;				// TRACE_MAGIC
+	uint32_t			version;			// TRACE_VERSION
+	int32_t				philos;				// number of philosophers
+	int32_t				must_eat;			// INT_MAX when not given
+	int64_t				time_to_die;		// (microseconds)
+	int64_t				time_to_eat;		// (microseconds)
+	int64_t				time_to_sleep;		// (microseconds)
+	int64_t				record_size;		// sizeof(t_event)
+	int32_t				resources;			// forks on the table
+	int32_t				needs;				// entries of the topology rows
+};
+
+/**
+ * '-t': the rules one philosopher ran with, see profile_load().
+ */
+struct s_trace_rules
+{
+	int64_t				time_to_die;		// (microseconds)
+	int64_t				shortest_meal;		// (microseconds), 0 for 'exp'
+	int32_t				must_eat;			// INT_MAX when not given
+	int32_t				pad;
+};
+
+/**
+ * '-L': head of the live stats file, followed by one 't_live_philo' per
+ * philosopher and rewritten by live_main() every LIVE_INTERVAL for
+ * philo_top. The fields that change are stored and loaded with relaxed
+ * atomics: a reader sees every value whole, but not all from one instant.
+ */
+struct s_live_header
+{
+	uint32_t			magic;				// LIVE_MAGIC
+	uint32_t			version;			// LIVE_VERSION
+	int32_t				philos;				// number of philosophers
+	int32_t				pid;				// of the run
+	int64_t				time_to_die;		// (microseconds) command line
+	int32_t				must_eat;			// INT_MAX when not given
+	atomic_int			status;				// enum e_live
+	_Atomic int64_t		elapsed;			// (microseconds) since the start
+	_Atomic int64_t		events;				// logged so far, every philo
+	atomic_int			full;				// philos that reached must_eat
+	atomic_uint			updates;			// bumped after every update
+};
+
+/**
+ * '-L': one philosopher in the live stats file, see 't_live_header'.
+ */
+struct s_live_philo
+{
+	atomic_int			meals;				// 'has_eaten'
+	atomic_int			doing;				// last enum e_state, -1 before
+	_Atomic int64_t		events;				// logged so far
+	_Atomic int64_t		hunger;				// (microseconds) since it ate
+	_Atomic int64_t		worst_margin;		// (microseconds) INT64_MAX before
+	int64_t				time_to_die;		// (microseconds) its own, '-P'
+	int32_t				must_eat;			// its own, INT_MAX for no limit
+	int32_t				pad;
+};
+
+/**
+ * '-g': the resources every philosopher needs for a meal, as compressed
+ * sparse rows: philosopher 'i' takes forks[needs[offsets[i]]] up to
+ * forks[needs[offsets[i + 1] - 1]], highest resource first, so the forks
+ * are always taken in one global order and no cycle of waiting philosophers
+ * can form. On a 'ring' the rows are fork2 and fork1 as order_forks() takes
+ * them. Generators and files first list (philosopher, resource) pairs, see
+ * topology_add().
+ */
+struct s_topology
+{
+	bool				ring;				// classic table, see philo_init()
+	int					resources;			// forks on the table
+	int					*offsets;			// total_philos + 1 row starts
+	int					*needs;				// offsets[total_philos] resources
+	int					*pairs;				// (philo, resource), until built
+	int					pair_count;
+	int					pair_cap;			// of (pairs), in pairs
+};
+
+/**
+ * 'regular:<k>' being generated: 'edges' edges, each a resource, with both
+ * ends in (ends) and every philosopher's 'k' neighbours in (adj).
+ */
+struct s_regular
+{
+	int					k;					// degree of every philosopher
+	int					edges;				// total_philos * k / 2
+	int					*ends;				// 2 per edge
+	int					*adj;				// k per philosopher
+	uint64_t			rng;				// seeded from '-d'
+};
+
+/**
+ * Timing rules: those of the command line, stored once in the monitor, and
+ * every philosopher's own copy, which '-P' may change, see profile_load().
+ * In a philosopher's copy 'time_to_eat' and 'time_to_sleep' are the means
+ * of its distributions, which is what the think policies plan with.
+ */
+struct s_rules
+{
+	int64_t				time_to_die;		// (microseconds)
+	int64_t				time_to_eat;		// (microseconds)
+	int64_t				time_to_sleep;		// (microseconds)
+	int					must_eat;
+};
+
+/**
+ * '-P': how long a meal or a sleep lasts, drawn by prng_duration(). 'fixed'
+ * is always 'mean'; 'uniform' is anywhere in [low, high]; 'exp' is
+ * exponential around 'mean', with 'low' 0 and no upper bound.
+ */
+struct s_duration
+{
+	int					kind;				// enum e_dist
+	int64_t				low;				// (microseconds) shortest
+	int64_t				high;				// (microseconds) longest
+	int64_t				mean;				// (microseconds)
+};
+
+/**
+ * A fork mutex padded to its own cache line, so locking one fork does not
+ * invalidate the line holding its neighbours.
+ */
+struct s_fork
+{
+	alignas(CACHE_LINE) pthread_mutex_t	mutex;
+	pthread_cond_t		cond;				// chandy, ticket: fork changed
+	int					owner;				// chandy: index of the holder
+	bool				dirty;				// chandy: used since handed over
+	bool				busy;				// chandy, waiter: being eaten with
+	unsigned int		next_ticket;		// ticket: next ticket to hand out
+	unsigned int		now_serving;		// ticket: ticket owning the fork
+	int					holder;				// pool: index holding it, or -1
+	int					parked;				// pool: first index waiting, or -1
+	int					parked_last;		// pool: last index waiting
+};
+
+/**
+ * The fields a philosopher writes while running, one cache line per
+ * philosopher so neighbours never false-share.
+ */
+struct s_philo_state
+{
+	alignas(CACHE_LINE) _Atomic int64_t	last_ate;	// read by the monitor
+	atomic_int			has_eaten;			// read by the monitor
+	atomic_int			doing;				// '-L': last enum e_state printed
+	_Atomic int64_t		events;				// '-L': printed so far
+	_Atomic int64_t		worst_margin;		// '-L': least time left at a meal
+	int64_t				total_wait;			// hungry to eating, summed
+	int64_t				max_wait;			// hungry to eating, worst case
+	int64_t				max_hunger;			// now - last_ate when eating
+};
+
+/**
+ * When a philosopher reaches for its forks, selected with '-p': how long
+ * it holds back at the start, and how long it thinks between sleeping and
+ * getting hungry. 'fixed' follows the timings alone, 'planned' the
+ * timetable of plan_build(), and 'adaptive' the timetable and its
+ * neighbours' 'last_ate' deadlines, see adaptive_think().
+ */
+struct s_policy
+{
+	const char			*name;
+	int64_t				(*stagger)(t_philo *p);
+	int64_t				(*think)(t_philo *p, int64_t now);
+	bool				planned;			// needs a timetable that survives
+};
+
+/**
+ * A fork-acquisition strategy: how a hungry philosopher gets both forks,
+ * how it gives them back and, if 'take' can block on a condition, how a
+ * stop wakes it. Selected with '-s' and shared by every
+ * philosopher through philo_main().
+ */
+struct s_strategy
+{
+	const char			*name;
+	void				(*init)(t_monitor *m);
+	void				(*take)(t_philo *p);
+	void				(*put)(t_philo *p);
+	void				(*wake)(t_monitor *m);
+};
+
+/**
+ * How the philosophers are run, selected with '-e': 'threads' gives each
+ * one a thread running philo_main(), 'pool' steps them as state machines
+ * on a few worker threads, 'des' simulates them on a virtual clock, and
+ * 'procs' runs their threads in child processes sharing the forks.
+ * 'wake' makes a philosopher parked on a fork runnable again; engines that
+ * block in the strategy leave it NULL.
+ */
+struct s_engine
+{
+	const char			*name;
+	int					(*start)(t_monitor *m);
+	void				(*stop)(t_monitor *m);
+	void				(*wake)(t_monitor *m, int idx);
+	bool				virtual_clock;		// time is (des.now), see sim_time()
+};
+
+/**
+ * '-L': the mapped live stats file and the thread updating it.
+ */
+struct s_live
+{
+	pthread_t			thread;
+	bool				started;			// thread is running
+	t_live_header		*map;				// NULL without '-L'
+	size_t				size;				// of (map)
+};
+
+/**
+ * Entry of the timer wheel, one per philosopher.
+ */
+struct s_timer
+{
+	int64_t				tick;				// when it fires, in WHEEL_TICKs
+	int					next;				// next timer in the slot, or -1
+};
+
+/**
+ * Hierarchical timer wheel: 'WHEEL_LEVELS' rings of 'WHEEL_SIZE' slots,
+ * each level 'WHEEL_SIZE' times coarser than the one below, so arming and
+ * firing a timer are O(1) whatever the number of philosophers.
+ */
+struct s_wheel
+{
+	int64_t				now;				// last tick processed
+	int					slots[WHEEL_LEVELS * WHEEL_SIZE];	// -1 if empty
+	t_timer				*timers;			// indexed by philosopher
+};
+
+/**
+ * FIFO of runnable philosopher indices shared by the pool's workers.
+ */
+struct s_runq
+{
+	pthread_mutex_t		mutex;				// guards everything below
+	pthread_cond_t		not_empty;			// workers wait for work
+	int					*items;
+	int					capacity;
+	int					head;
+	int					count;
+	bool				closed;				// workers exit once set
+};
+
+/**
+ * A timer wheel and the thread firing it, with one timer per philosopher:
+ * used by the 'pool' workers, and by the philosopher threads with '-w'.
+ */
+struct s_timers
+{
+	pthread_t			thread;
+	bool				initialized;		// lock and condition exist
+	bool				started;			// thread is running
+	pthread_mutex_t		mutex;				// guards everything below
+	pthread_cond_t		cond;				// wakes the thread early
+	t_wheel				wheel;
+	int64_t				due;				// tick the thread sleeps until
+	bool				closed;				// timers_arm() fails once set
+	void				(*fire)(t_monitor *m, int id);
+	t_monitor			*monitor;			// passed to (fire)
+};
+
+/**
+ * State of the 'pool' engine.
+ */
+struct s_pool
+{
+	pthread_t			*workers;
+	int					workers_created;	// threads successfully created
+	atomic_int			placed;				// workers placed, '-a' and '-F'
+	t_runq				runq;
+};
+
+/**
+ * Entry of the 'des' engine's event queue: philosopher 'idx' runs at 'time'.
+ */
+struct s_des_event
+{
+	int64_t				time;				// virtual time (microseconds)
+	uint64_t			key;				// breaks ties, drawn from the seed
+	int					idx;
+};
+
+/**
+ * State of the 'des' engine.
+ */
+struct s_des
+{
+	int64_t				now;				// virtual clock (microseconds)
+	uint64_t			rng;				// seeded from '-d'
+	t_des_event			*events;			// min-heap on (time, key)
+	int					size;
+};
+
+/**
+ * Head of the memory the 'procs' engine shares with its children, followed
+ * by the philosophers' states, forks and histograms. Futex words are waited
+ * on with futex_wait_shared(); the ring carries the children's events to
+ * the parent's log, see relay_push().
+ */
+struct s_shared
+{
+	atomic_uint			stop;				// raised by the parent
+	atomic_uint			ready;				// children parked at the gate
+	atomic_uint			gate;				// (start_time) is published
+	atomic_uint			events;				// bumped on every relay_push()
+	atomic_uint			relay_idle;			// relay sleeps on (events)
+	atomic_int			full;				// philos that reached must_eat
+	_Atomic int64_t		start_time;
+	pthread_mutex_t		mutex;				// process-shared, guards the ring
+	uint64_t			head;				// next event for the relay
+	uint64_t			tail;				// next free slot
+	t_event				ring[LOG_CAPACITY];
+};
+
+/**
+ * State of the 'procs' engine: one child process per group of neighbours,
+ * see procs_start(). While it runs (states), (forks) and (stats) of the
+ * monitor point into (shared), and the arrays they replaced are kept here.
+ */
+struct s_procs
+{
+	t_shared			*shared;			// mapping shared with the children
+	size_t				size;				// of the mapping
+	pid_t				*pids;				// one per group
+	int					groups;				// children forked
+	pthread_t			relay;				// parent: relay_main()
+	bool				relay_started;
+	atomic_bool			relay_done;			// children reaped, drain and exit
+	bool				child;				// this is a child process
+	t_philo_state		*states;			// private arrays, back at the end
+	t_fork				*forks;
+	t_stats				*stats;
+};
+
+/**
+ * Log-linear latency histogram in the style of HdrHistogram: one bucket per
+ * value below 'HIST_SUB_COUNT', then 'HIST_SUB_COUNT' buckets per power of
+ * two, so every sample is kept to within 1/16 of its size.
+ */
+struct s_hist
+{
+	int64_t				count;
+	int64_t				sum;
+	int64_t				min;
+	int64_t				max;
+	uint32_t			buckets[HIST_BUCKETS];
+};
+
+/**
+ * '-H', '-J', philo_bench: the histograms of one philosopher, one per
+ * enum e_stat. Only the thread running the philosopher writes them, so
+ * recording needs no lock; stats_merge() folds them together once the
+ * engine has stopped.
+ */
+struct s_stats
+{
+	alignas(CACHE_LINE) t_hist	hist[STAT_KINDS];
+};
+
+/**
+ * Arbitrator for the 'waiter' strategy: hungry philosophers take a ticket
+ * and are seated in ticket order among those competing for the same forks.
+ */
+struct s_waiter
+{
+	pthread_mutex_t		mutex;				// guards tickets and fork.busy
+	uint64_t			next_ticket;
+};
+
+/**
+ * Entry of the option table in parse_options(). 'set' receives the value
+ * following the flag, or the flag itself when 'has_value' is false.
+ */
+struct s_option
+{
+	char				flag;
+	bool				has_value;
+	int					(*set)(t_options *opts, const char *value);
+};
+
+/**
+ * Per-run figures gathered from every philosopher by report_print().
+ */
+struct s_summary
+{
+	int64_t				meals;
+	int					min_meals;
+	int					max_meals;
+	double				meals_squared;		// for Jain's fairness index
+	int64_t				total_wait;
+	int64_t				max_wait;
+	int64_t				max_hunger;
+};
+
+/**
+ * Command-line options given before the positional arguments.
+ */
+struct s_options
+{
+	const t_strategy	*strategy;			// '-s', fork acquisition
+	const t_engine		*engine;			// '-e', how philos are run
+	const t_policy		*policy;			// '-p', when to get hungry
+	bool				policy_given;		// '-p' was given, not the default
+	int					workers;			// '-j', threads of 'pool'
+	unsigned int		seed;				// '-d', seed of 'des'
+	bool				wheel;				// '-w', threads wait on (timers)
+	bool				report;				// '-r', run summary on stderr
+	bool				stats;				// '-H', histograms on stderr
+	bool				histograms;			// '-H', '-J', collect them
+	const char			*stats_file;		// '-J', histograms as JSON
+	const char			*trace_file;		// '-t', binary trace, no text
+	const char			*batch_file;		// '-b', configurations to run
+	int					affinity;			// '-a', enum e_affinity
+	bool				fifo;				// '-F', SCHED_FIFO threads
+	size_t				stack_size;			// '-S', philo stacks, 0 for default
+	int					shards;				// '-m', monitor threads, 0 for auto
+	const char			*topology;			// '-g', NULL for a ring
+	const char			*profile;			// '-P', per-philosopher timings
+	const char			*live_file;			// '-L', live stats for philo_top
+};
+
+/**
+ * '-a', '-F': the CPUs and scheduling policy of the thread that started the
+ * run, see affinity_save().
+ */
+struct s_affinity
+{
+	cpu_set_t			allowed;			// CPUs the run may use
+	int					count;				// CPUs in (allowed)
+	int					policy;				// to restore at the end
+	struct sched_param	param;				// to restore at the end
+	bool				saved;				// the above are set
+	atomic_bool			warned;				// SCHED_FIFO refusal reported
+};
+
+/**
+ * '-b': runs of a batch share the CPUs. A run is admitted once the threads
+ * it needs fit in 'budget' next to the runs already going, so timing is not
+ * distorted by oversubscription; a run larger than the budget runs alone.
+ */
+struct s_batch
+{
+	pthread_mutex_t		mutex;				// guards (in_use)
+	pthread_cond_t		freed;				// a run gave its threads back
+	int					budget;				// CPUs the process may run on
+	int					in_use;				// threads of the admitted runs
+	int					line;				// line of the batch file read last
+	atomic_bool			failed;				// a bad line or a failed run
+	pthread_t			*threads;			// of the runs, see batch_run()
+	int					spawned;			// runs in (threads)
+	int					capacity;			// of (threads)
+	const char			*file;				// '-b', the batch file
+	t_options			opts;				// of every run, see batch_init()
+};
+
+/**
+ * One simulation of a batch, run on its own thread with its events written
+ * to '<batch_file>.<line>.log'.
+ */
+struct s_batch_run
+{
+	t_batch				*batch;
+	t_philo_sim			*sim;
+	FILE				*log;				// text log of the run
+	int					line;				// line of its configuration
+	int					cost;				// threads it needs, see run_cost()
+	char				path[BATCH_PATH_MAX];	// of (log)
+};
+
+/**
+ * Entry of the monitor's min-heap: when philosopher 'idx' dies unless it eats.
+ */
+struct s_deadline
+{
+	int64_t				deadline;			// INT64_MAX once the philo is full
+	int					idx;				// index into the philos array
+};
+
+/**
+ * A monitor thread watching the deadlines of a contiguous range of the
+ * philosophers, see loop_monitor(). Shard 0 is the thread running the
+ * simulation and watches the last range.
+ */
+struct s_shard
+{
+	t_monitor			*monitor;
+	t_deadline			*heap;				// (count) entries of (deadlines)
+	int					count;				// philosophers watched
+	int					index;				// in (shards)
+	pthread_t			thread;				// unused for shard 0
+};
+
+/**
+ * Ring of events filled by the philosophers and drained by a single writer
+ * thread, which formats them and flushes them to stdout in large batches.
+ */
+struct s_log
+{
+	pthread_t			thread;				// writer thread
+	bool				started;			// writer thread is running
+	pthread_mutex_t		mutex;				// guards everything below
+	pthread_cond_t		not_empty;			// writer waits for records
+	pthread_cond_t		not_full;			// producers wait for space
+	uint64_t			head;				// next record to format
+	uint64_t			tail;				// next free slot
+	bool				writer_idle;		// writer is parked on not_empty
+	bool				closed;				// no more records will come
+	t_event				death;				// 'died' record, nothing follows it
+	t_philo_event_fn	sink;				// gets the records instead of (fd)
+	void				*sink_ctx;			// passed to (sink)
+	int					fd;					// stdout, or the '-t' trace
+	bool				binary;				// write raw records to (fd)
+	t_event				ring[LOG_CAPACITY];
+	char				out[LOG_BUFFER_SIZE];
+};
 
 struct s_monitor
 {
 	int					total_philos;		// total number of philos
-	int					threads_created;	// threads successfully created
-	pthread_mutex_t		*forks;				// array of the fork mutexes
-	pthread_mutex_t		philo_mutex;		// lock held for various data
-	bool				death_printed;		// protected by (philo_mutex)
+	int					spawners;			// threads creating the philos
+	t_rules				rules;				// timing rules from the arguments
+	t_rules				bounds;				// slowest of every philo's, '-P'
+	int64_t				plan_period;		// between meals, see plan_build()
+	t_options			opts;				// command-line options
+	t_waiter			waiter;				// used by the 'waiter' strategy
+	t_pool				pool;				// used by the 'pool' engine
+	t_timers			timers;				// used by 'pool' and '-w'
+	t_des				des;				// used by the 'des' engine
+	t_procs				procs;				// used by the 'procs' engine
+	t_topology			topology;			// resources of every meal, '-g'
+	t_affinity			affinity;			// used by '-a' and '-F'
+	t_live				live;				// used by '-L'
+	t_fork				*forks;				// (topology.resources) fork mutexes
+	t_philo_state		*states;			// hot state, one line per philo
+	t_stats				*stats;				// one per philo, NULL if off
+	FILE				*stats_json;		// '-J' file, see stats_start()
+	alignas(CACHE_LINE) t_log	log;		// asynchronous event log
+	t_deadline			*deadlines;			// min-heaps, one per shard
+	t_shard				*shards;			// (shard_count) monitor threads
+	int					shard_count;		// see monitor_shards()
+	int64_t				detect_latency;		// death to its detection
+	atomic_int			full_philos;		// philos that reached must_eat
+	pthread_mutex_t		wake_mutex;			// pairs with (wake_cond)
+	pthread_cond_t		wake_cond;			// wakes the monitor early
+	atomic_uint			stop_simulation;	// 0 or 1, also a futex word
+	_Atomic int64_t		stop_time;			// when it was set
+	_Atomic int64_t		start_time;			// published once by the monitor
+	int64_t				end_time;			// set by stop_monitor()
+	int64_t				stop_latency;		// stop_time to every thread joined
+	int64_t				created_at;			// by philo_sim_create()
+	atomic_uint			ready;				// philos at the start gate
+	atomic_uint			gate;				// GATE_OPEN, GATE_STOPPED bits
+	char				*stacks;			// '-S', every philo stack
+	size_t				stacks_size;		// of (stacks)
+	int					args[5];			// positional arguments, see run.c
 	t_philo				*philos;			// array of philosophers
 };
 
@@ -47,25 +691,26 @@ struct s_philo
 	t_monitor			*monitor;			// back-pointer to the monitor
 	int					id;					// id of the philo starting from 1
 	pthread_t			thread;				// thread of the philosopher
-	int64_t				time_to_die;
-	int64_t				time_to_eat;
-	int64_t				time_to_sleep;
-	int					must_eat;
-	pthread_mutex_t		*fork1;
-	pthread_mutex_t		*fork2;
-	bool				stop_simulation;	// protected by (philo_mutex)
-	int64_t				start_time;			// protected by (philo_mutex)
-	int64_t				last_ate;			// protected by (philo_mutex)
-	int					has_eaten;			// protected by (philo_mutex)
-};
-
-enum e_state
-{
-	TOOK_FORK,
-	EATING,
-	SLEEPING,
-	THINKING,
-	DEAD,
+	t_fork				*fork1;				// ring only, NULL otherwise
+	t_fork				*fork2;				// ring only, NULL for a lone philo
+	const int			*needs;				// its row of (topology)
+	int					need_count;			// forks it eats with
+	bool				lone;				// under two forks, can never eat
+	t_philo_state		*state;				// this philo's entry in (states)
+	uint64_t			ticket;				// waiter: 0 when not waiting
+	pthread_cond_t		turn;				// waiter: signalled on put
+	sem_t				wakeup;				// '-w': posted when the timer fires
+	int					phase;				// pool: enum e_phase, next step
+	int					forks_held;			// pool: forks taken so far
+	int					parked_next;		// pool: next waiting on the fork
+	int64_t				wake_at;			// pool: when the step is due
+	int64_t				hungry_since;		// pool: start of the fork wait
+	bool				has_thread;			// threads: created, to be joined
+	int64_t				plan_offset;		// first meal, see plan_build()
+	t_rules				rules;				// its own, see profile_load()
+	t_duration			eat;				// of every meal, '-P'
+	t_duration			sleep;				// of every sleep, '-P'
+	uint64_t			rng;				// draws (eat) and (sleep)
 };
 
 enum e_monitoring
@@ -80,28 +725,357 @@ enum e_eating
 	KEEP_EATING,
 };
 
+enum e_stat
+{
+	STAT_FORK_WAIT,
+	STAT_EAT_MARGIN,
+	STAT_OVERSLEEP,
+	STAT_LOCK_WAIT,
+};
+
+enum e_affinity
+{
+	AFFINITY_NONE,
+	AFFINITY_RR,
+	AFFINITY_BLOCK,
+};
+
+enum e_live
+{
+	LIVE_RUNNING,
+	LIVE_STOPPED,
+};
+
+enum e_dist
+{
+	DIST_FIXED,
+	DIST_UNIFORM,
+	DIST_EXP,
+};
+
+enum e_phase
+{
+	PHASE_START,
+	PHASE_THINK,
+	PHASE_HUNGRY,
+	PHASE_EAT,
+	PHASE_REST,
+};
+
+// run.c
+int		run_free(t_monitor *m);
+int		run_simulation(t_monitor *m, int args[5]);
+
+// api_config.c
+int		parse_args(int ac, char **av, int args[5]);
+
+// batch.c
+void	batch_admit(t_batch *b, int cost);
+int		batch_run(const t_options *opts);
+
+// batch_thread.c
+void	batch_start(t_batch *b, char *line);
+
+// batch_file.c
+int		batch_parse_line(char *line, int args[5]);
+t_batch_run	*batch_new_run(t_batch *b, int args[5]);
+void	batch_free_run(t_batch_run *r);
+
+// affinity.c
+void	affinity_place(t_monitor *m, int idx, int count);
+void	affinity_monitor(t_monitor *m, int shard);
+
+// affinity_save.c
+void	affinity_save(t_monitor *m);
+void	affinity_restore(t_monitor *m);
+
 // monitor.c
+void	init_rules(t_rules *r, int args[5]);
 int		start_monitor(t_monitor *monitor, int args[5]);
+int		stop_monitor(t_monitor *monitor);
+
+// monitor_loop.c
+void	shard_watch(t_shard *s);
+void	monitor_wake(t_monitor *m);
+
+// monitor_shard.c
+int		monitor_shards(t_monitor *m);
 void	loop_monitor(t_monitor *monitor);
-void	stop_monitor(t_monitor *monitor);
+void	monitor_notify_full(t_monitor *monitor);
+
+// heap.c
+void	heap_build(t_monitor *m, t_deadline *heap, int count);
+void	heap_sift_down(t_deadline *heap, int size, int i);
 
 // philo.c
-void	philo_init(t_philo *philo, t_monitor *m, int index, int args[5]);
+void	philo_init(t_philo *philo, t_monitor *m, int index);
 void	*philo_main(void *philo);
 void	philo_print(t_philo *p, enum e_state state);
 
 // forks_and_eat.c
+void	record_wait(t_philo *p, int64_t wait);
 void	take_forks(t_philo *p);
+void	meal_begin(t_philo *p);
+int		meal_end(t_philo *p);
 int		eat_and_check_saturation(t_philo *p);
 
+// options.c
+void	options_defaults(t_options *opts);
+int		parse_options(int ac, char **av, t_options *opts);
+
+// options_set.c
+int		set_strategy(t_options *opts, const char *value);
+int		set_engine(t_options *opts, const char *value);
+int		set_workers(t_options *opts, const char *value);
+int		set_seed(t_options *opts, const char *value);
+int		set_batch(t_options *opts, const char *value);
+
+// options_sched.c
+int		set_affinity(t_options *opts, const char *value);
+int		set_fifo(t_options *opts, const char *value);
+int		set_stack(t_options *opts, const char *value);
+int		set_policy(t_options *opts, const char *value);
+int		set_topology(t_options *opts, const char *value);
+
+// options_monitor.c
+int		set_shards(t_options *opts, const char *value);
+int		set_live(t_options *opts, const char *value);
+
+// options_timing.c
+int		set_profile(t_options *opts, const char *value);
+
+// options_flags.c
+int		set_report(t_options *opts, const char *value);
+int		set_wheel(t_options *opts, const char *value);
+int		set_stats(t_options *opts, const char *value);
+int		set_stats_file(t_options *opts, const char *value);
+int		set_trace(t_options *opts, const char *value);
+
+// parse.c
+int		parse_nbr(const char *s);
+
+// engine.c
+void	publish_start_time(t_monitor *m, int64_t delay);
+const t_engine	*engine_find(const char *name);
+void	engine_fallback(t_monitor *m);
+
+// engine_threads.c
+void	threads_wake(t_monitor *m, int idx);
+int		threads_start(t_monitor *m);
+void	threads_stop(t_monitor *m);
+
+// engine_spawn.c
+int		spawn_philos(t_monitor *m);
+
+// procs.c
+int		procs_start(t_monitor *m);
+void	procs_stop(t_monitor *m);
+
+// procs_child.c
+void	procs_child(t_monitor *m, int first, int count);
+int		procs_gate(t_monitor *m);
+
+// procs_relay.c
+void	relay_push(t_monitor *m, int id, enum e_state state);
+void	*relay_main(void *arg);
+void	relay_full(t_monitor *m);
+
+// pool.c
+void	pool_wake(t_monitor *m, int idx);
+int		pool_start(t_monitor *m);
+void	pool_stop(t_monitor *m);
+
+// timers.c
+int		timers_start(t_timers *t, t_monitor *m,
+			void (*fire)(t_monitor *, int));
+int		timers_arm(t_timers *t, int id, int64_t when);
+void	timers_stop(t_timers *t);
+
+// runq.c
+int		runq_init(t_runq *q, int capacity);
+void	runq_push(t_runq *q, int id);
+int		runq_pop(t_runq *q);
+void	runq_close(t_runq *q);
+void	runq_destroy(t_runq *q);
+
+// wheel.c
+void	wheel_insert(t_wheel *w, int id, int64_t when);
+void	wheel_advance(t_wheel *w, int64_t tick,
+			void (*fire)(t_monitor *, int), t_monitor *m);
+
+// wheel_utils.c
+int		wheel_init(t_wheel *w, int count, int64_t now);
+int64_t	wheel_next(t_wheel *w);
+
+// des.c
+void	des_wake(t_monitor *m, int idx);
+int		des_start(t_monitor *m);
+void	des_stop(t_monitor *m);
+
+// des_queue.c
+void	des_push(t_des *d, int idx, int64_t time);
+t_des_event	des_pop(t_des *d);
+
+// topology.c
+int		topology_add(t_topology *t, int philo, int resource);
+int		topology_build(t_monitor *m);
+void	topology_free(t_topology *t);
+
+// topology_rows.c
+int		topology_rows(t_monitor *m);
+
+// topology_gen.c
+int		topology_ring(t_monitor *m);
+int		topology_grid(t_monitor *m);
+int		topology_complete(t_monitor *m);
+
+// topology_regular.c
+int		topology_regular(t_monitor *m, int k);
+
+// topology_file.c
+int		topology_file(t_monitor *m, const char *path);
+
+// prng.c
+void	prng_seed(uint64_t *state, uint64_t seed);
+uint64_t	prng_next(uint64_t *state);
+int64_t	prng_duration(uint64_t *state, const t_duration *d);
+
+// profile.c
+void	profile_set(t_philo *p, int key, const t_duration *d);
+int		profile_load(t_monitor *m, int args[5]);
+
+// profile_parse.c
+int		profile_line(t_monitor *m, char *line);
+
+// step.c
+int64_t	philo_step(t_philo *p, int64_t now);
+
+// step_forks.c
+int64_t	step_take_forks(t_philo *p, int64_t now);
+void	step_put_forks(t_philo *p);
+
+// schedule.c
+const t_policy	*policy_find(const char *name);
+int64_t	stagger_delay(t_philo *p);
+void	stagger_starting_times(t_philo *p);
+int64_t	think_time(t_philo *p, int64_t now);
+
+// schedule_adaptive.c
+int64_t	adaptive_think(t_philo *p, int64_t now);
+
+// plan.c
+void	plan_build(t_monitor *m);
+int64_t	plan_stagger(t_philo *p);
+int64_t	plan_think(t_philo *p, int64_t now);
+
+// strategy.c
+const t_strategy	*strategy_find(const char *name);
+void	strategy_init(t_monitor *m);
+void	strategy_destroy(t_monitor *m);
+t_philo	*philo_left(t_philo *p);
+t_philo	*philo_right(t_philo *p);
+
+// strategy_ordered.c
+void	order_forks(t_philo *p, t_fork **first, t_fork **second);
+void	ordered_take(t_philo *p);
+void	ordered_put(t_philo *p);
+void	trylock_take(t_philo *p);
+
+// strategy_waiter.c
+void	waiter_take(t_philo *p);
+void	waiter_put(t_philo *p);
+void	waiter_wake(t_monitor *m);
+
+// strategy_ticket.c
+void	ticket_take(t_philo *p);
+void	ticket_put(t_philo *p);
+
+// strategy_chandy.c
+void	chandy_init(t_monitor *m);
+void	chandy_take(t_philo *p);
+void	chandy_put(t_philo *p);
+
+// report.c
+void	report_collect(t_monitor *m, t_summary *s);
+void	report_print(t_monitor *m);
+
+// stats.c
+int		stats_start(t_monitor *m);
+void	stats_record(t_philo *p, int kind, int64_t value);
+void	stats_lock(t_philo *p, pthread_mutex_t *mutex);
+void	stats_wakeup(t_philo *p, int64_t now);
+
+// stats_report.c
+const char	*stats_name(int kind);
+void	stats_merge(t_monitor *m, t_hist total[STAT_KINDS]);
+int		stats_report(t_monitor *m);
+
+// stats_json.c
+FILE	*stats_open_json(t_monitor *m);
+int		stats_write_json(t_monitor *m, const t_hist total[STAT_KINDS]);
+
+// hist.c
+int64_t	hist_bucket_value(int idx);
+void	hist_record(t_hist *h, int64_t value);
+void	hist_merge(t_hist *dst, const t_hist *src);
+int64_t	hist_percentile(const t_hist *h, double q);
+
+// log.c
+int		log_start(t_log *log);
+t_event	*log_slot(t_log *log);
+void	log_commit(t_log *log, t_event *event);
+void	log_push(t_monitor *m, int id, enum e_state state);
+void	log_close(t_log *log);
+
+// trace.c
+int		trace_open(t_monitor *m);
+
+// live.c
+int		live_open(t_monitor *m);
+int		live_start(t_monitor *m);
+void	live_stop(t_monitor *m);
+void	live_close(t_monitor *m);
+
+// live_publish.c
+void	live_publish(t_monitor *m, int status);
+
+// log_drain.c
+void	log_drain(t_log *log, uint64_t head, uint64_t tail);
+
+// log_writer.c
+void	*log_writer_main(void *arg);
+
+// log_format.c
+int		log_format_event(char *dst, const t_event *event);
+
 // get.c
 bool	get_stop_simulation(t_philo *p);
+bool	set_stop_simulation(t_monitor *m);
 int64_t	get_start_time(t_philo *p);
+int64_t	get_last_ate(t_philo *p);
+int		get_has_eaten(t_philo *p);
 
-// time.c
+// clock.c
 int64_t	current_time(void);
+int64_t	sim_time(t_monitor *m);
+
+// futex.c
+void	futex_wait(atomic_uint *word, unsigned int seen, int64_t target_time);
+void	futex_wake(atomic_uint *word);
+void	futex_wait_shared(atomic_uint *word, unsigned int seen,
+			int64_t target_time);
+void	futex_wake_shared(atomic_uint *word);
+
+// gate.c
 void	wait_for_start_time(t_philo *p);
-void	stagger_starting_times(t_philo *p);
+void	gate_open(t_monitor *m);
+
+// stop.c
+void	stop_sleep_until(t_monitor *m, int64_t target_time);
+void	stop_broadcast(t_monitor *m);
+void	stop_wake_forks(t_monitor *m);
+
+// time.c
 void	wait_until(t_philo *philo, int64_t target_time);
 void	wait_for(t_philo *philo, int64_t duration);
 
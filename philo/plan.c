@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 06:58:22 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:02:13 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Time between two meals of the same philosopher in the tightest rotation
+ * of the table. At most half of the philosophers, 'k', eat at once, so a
+ * round of one meal each takes 'philos / k' meals: two on an even table,
+ * a little more on an odd one. Never shorter than eating and sleeping.
+ * With '-P' every slot is as long as the slowest mean meal of the table,
+ * see (bounds); drawn meals longer than that run into the next slot.
+ *
+ * @param m Monitor of at least two philosophers.
+ * @return Period in microseconds.
+ */
+static int64_t	plan_period(t_monitor *m)
+{
+	const int64_t	k = m->total_philos / 2;
+	int64_t			period;
+
+	period = m->total_philos * m->bounds.time_to_eat / k;
+	if (period < m->bounds.time_to_eat + m->bounds.time_to_sleep)
+		period = m->bounds.time_to_eat + m->bounds.time_to_sleep;
+	return (period);
+}
+
+/**
+ * First meal of philosopher 'id' in the rotation of plan_period(). On an
+ * even table odd philosophers hold back a meal. On an odd one they start
+ * a 'k'th of a meal apart, every second one around the table (1, 3, 5,
+ * ..., 2, 4, ...), so each starts as its neighbours are done.
+ *
+ * @return Delay after 'start_time' in microseconds.
+ */
+static int64_t	plan_offset(t_monitor *m, int id)
+{
+	int64_t	slot;
+
+	if (m->total_philos % 2 == 0)
+		return ((id % 2) * m->bounds.time_to_eat);
+	slot = (id - 1) / 2;
+	if (id % 2 == 0)
+		slot = (m->total_philos - 1) / 2 + id / 2;
+	return (slot * m->bounds.time_to_eat / (m->total_philos / 2));
+}
+
+/**
+ * Work out the timetable of the table, before anything runs: the period
+ * and every philosopher's first meal. With '-p planned', a table no
+ * timetable keeps alive (a lone philosopher, or a period that is not
+ * shorter than the shortest 'time_to_die') is reported on stderr and run
+ * with '-p adaptive' instead, fighting over the forks as usual.
+ *
+ * @param m Monitor with the philosophers and the rules initialized.
+ */
+void	plan_build(t_monitor *m)
+{
+	int	i;
+
+	i = 0;
+	while (m->total_philos > 1 && i < m->total_philos)
+	{
+		m->philos[i].plan_offset = plan_offset(m, m->philos[i].id);
+		i++;
+	}
+	if (m->total_philos > 1)
+		m->plan_period = plan_period(m);
+	if (!m->opts.policy->planned || (m->total_philos > 1
+			&& m->plan_period < m->bounds.time_to_die))
+		return ;
+	if (m->total_philos == 1)
+		fprintf(stderr, "planner: a lone philosopher cannot eat");
+	else
+		fprintf(stderr, "planner: a round takes %.3f ms, time_to_die is "
+			"%.3f ms", m->plan_period / 1e3, m->bounds.time_to_die / 1e3);
+	fprintf(stderr, ", falling back to '-p adaptive'\n");
+	m->opts.policy = policy_find("adaptive");
+}
+
+/**
+ * 'planned', 'adaptive': start at the philosopher's first meal of the
+ * timetable, see plan_build().
+ */
+int64_t	plan_stagger(t_philo *p)
+{
+	return (p->plan_offset);
+}
+
+/**
+ * 'planned': think until the philosopher's next meal of the timetable,
+ * counted from 'start_time' so lateness does not add up. On time, the
+ * neighbours are done with the forks by then, so taking them never waits.
+ *
+ * @param p Philosopher thinking.
+ * @param now Current time in microseconds.
+ * @return Time to think in microseconds, 0 if the meal is due.
+ */
+int64_t	plan_think(t_philo *p, int64_t now)
+{
+	int64_t	until;
+
+	until = get_start_time(p) + p->plan_offset
+		+ get_has_eaten(p) * p->monitor->plan_period;
+	if (until <= now)
+		return (0);
+	return (until - now);
+}
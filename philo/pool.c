@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:51:16 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Queue philosopher 'idx' to be stepped by a worker. Used both as the
+ * timer wheel's callback and by a fork handed over to a parked philosopher.
+ *
+ * @param m Monitor owning the pool.
+ * @param idx Index of the philosopher.
+ */
+void	pool_wake(t_monitor *m, int idx)
+{
+	runq_push(&m->pool.runq, idx);
+}
+
+/**
+ * Worker thread: step runnable philosophers and arm the timer of each one
+ * that has to wait for a time, until the run queue is closed. With '-a'
+ * or '-F' it is placed first, like a philosopher thread would be.
+ *
+ * @param arg Pointer to the monitor.
+ * @return NULL.
+ */
+static void	*pool_worker_main(void *arg)
+{
+	t_monitor *const	m = arg;
+	int					idx;
+	int64_t				when;
+
+	affinity_place(m, atomic_fetch_add(&m->pool.placed, 1), m->opts.workers);
+	idx = runq_pop(&m->pool.runq);
+	while (idx != -1)
+	{
+		when = philo_step(&m->philos[idx], current_time());
+		if (when >= 0)
+			timers_arm(&m->timers, idx, when);
+		idx = runq_pop(&m->pool.runq);
+	}
+	return (NULL);
+}
+
+/**
+ * Allocate the run queue and the worker array.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	pool_alloc(t_monitor *m)
+{
+	t_pool *const	pool = &m->pool;
+
+	if (runq_init(&pool->runq, m->total_philos) == -1)
+		return (-1);
+	pool->workers = malloc(m->opts.workers * sizeof(pthread_t));
+	if (pool->workers == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * 'pool' engine: run the philosophers as state machines (philo_step()) on
+ * 'opts.workers' threads, with the timer service for every timed wait. Every
+ * philosopher is queued once to arm its start timer. The forks are taken
+ * in order, see engine_fallback().
+ *
+ * @param m Monitor with the table initialized.
+ * @return 0 on success, -1 on allocation or pthread_create failure.
+ */
+int	pool_start(t_monitor *m)
+{
+	t_pool *const	pool = &m->pool;
+	int				i;
+
+	engine_fallback(m);
+	if (pool_alloc(m) == -1)
+		return (-1);
+	publish_start_time(m, THREAD_START_DELAY);
+	if (timers_start(&m->timers, m, pool_wake) == -1)
+		return (-1);
+	while (pool->workers_created < m->opts.workers)
+	{
+		if (pthread_create(&pool->workers[pool->workers_created], NULL,
+				pool_worker_main, m) != 0)
+			return (-1);
+		pool->workers_created++;
+	}
+	i = 0;
+	while (i < m->total_philos)
+		runq_push(&pool->runq, i++);
+	return (0);
+}
+
+/**
+ * Close the run queue and the timer service and join the workers. Does
+ * nothing if pool_start() never got as far as the run queue.
+ *
+ * @param m Monitor owning the pool.
+ */
+void	pool_stop(t_monitor *m)
+{
+	t_pool *const	pool = &m->pool;
+
+	if (pool->runq.capacity == 0)
+		return ;
+	runq_close(&pool->runq);
+	timers_stop(&m->timers);
+	while (pool->workers_created > 0)
+		pthread_join(pool->workers[--pool->workers_created], NULL);
+	free(pool->workers);
+	runq_destroy(&pool->runq);
+}
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   prng.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:36:04 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:36:04 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Seed a generator state. The seed goes through one round of splitmix64,
+ * so small or zero seeds still give a well-mixed, non-zero state.
+ *
+ * @param state Generator state to set.
+ * @param seed Any value, the same seed gives the same sequence.
+ */
+void	prng_seed(uint64_t *state, uint64_t seed)
+{
+	uint64_t	z;
+
+	z = seed + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z ^= z >> 31;
+	if (z == 0)
+		z = 1;
+	*state = z;
+}
+
+/**
+ * xorshift64*: a few shifts and one multiply per number, good enough for
+ * breaking ties and drawing durations, not for anything cryptographic.
+ *
+ * @param state Generator state, advanced.
+ * @return Next pseudo-random 64-bit value.
+ */
+uint64_t	prng_next(uint64_t *state)
+{
+	uint64_t	x;
+
+	x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return (x * 0x2545F4914F6CDD1DULL);
+}
+
+/**
+ * -ln(u) for 'u' in (0, 1], without libm: 'u' is scaled to 'x' * 2^-e with
+ * 'x' in [1, 2), and ln(x) = 2 atanh((x - 1) / (x + 1)) converges in a few
+ * terms since the ratio stays below 1/3.
+ */
+static double	neg_log(double u)
+{
+	double	t;
+	double	t2;
+	int		e;
+
+	e = 0;
+	while (u < 1)
+	{
+		u *= 2;
+		e++;
+	}
+	t = (u - 1) / (u + 1);
+	t2 = t * t;
+	t *= 2 * (1 + t2 * (1 / 3.0 + t2 * (1 / 5.0 + t2 * (1 / 7.0
+						+ t2 * (1 / 9.0 + t2 / 11.0)))));
+	return (e * 0.69314718055994531 - t);
+}
+
+/**
+ * '-P': draw how long one meal or sleep lasts. 'fixed' never touches the
+ * generator, so runs without a profile see exactly the durations they
+ * always did; the others cost a prng_next() and, for 'exp', a short series.
+ *
+ * @param state Generator of the philosopher, advanced.
+ * @param d Distribution, see profile_line().
+ * @return Duration in microseconds.
+ */
+int64_t	prng_duration(uint64_t *state, const t_duration *d)
+{
+	double	u;
+
+	if (d->kind == DIST_FIXED)
+		return (d->mean);
+	if (d->kind == DIST_UNIFORM)
+		return (d->low + prng_next(state) % (d->high - d->low + 1));
+	u = ((prng_next(state) >> 11) + 1) * 0x1p-53;
+	return ((int64_t)(d->mean * neg_log(u)));
+}
@@ -0,0 +1,175 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   procs.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:14:03 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:50:12 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Point the monitor and every philosopher at the given states, forks and
+ * histograms (if there are any): the shared copies while 'procs' runs, the
+ * private ones after.
+ */
+static void	procs_point(t_monitor *m, t_philo_state *states, t_fork *forks,
+	t_stats *stats)
+{
+	t_philo	*p;
+	int		i;
+
+	m->states = states;
+	m->forks = forks;
+	if (m->stats != NULL)
+		m->stats = stats;
+	i = 0;
+	while (i < m->total_philos)
+	{
+		p = &m->philos[i];
+		p->state = &states[i];
+		if (p->fork1 != NULL)
+			p->fork1 = &forks[i];
+		if (p->fork2 != NULL)
+			p->fork2 = &forks[(i + 1) % m->total_philos];
+		i++;
+	}
+}
+
+/**
+ * Map the memory shared with the children: the 't_shared' head, then the
+ * philosophers' states, forks and histograms, and move the table onto it,
+ * see procs_point(). The mapping starts zeroed; the ring and fork mutexes
+ * are made process-shared.
+ *
+ * @return 0 on success, -1 if the mapping failed.
+ */
+static int	procs_map(t_monitor *m, t_procs *pr)
+{
+	pthread_mutexattr_t	attr;
+	size_t				head;
+	char				*base;
+	t_fork				*forks;
+	int					i;
+
+	head = (sizeof(t_shared) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+	pr->size = head + m->total_philos * (sizeof(t_philo_state)
+			+ sizeof(t_stats)) + m->topology.resources * sizeof(t_fork);
+	base = mmap(NULL, pr->size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+		return (-1);
+	pr->shared = (t_shared *)base;
+	forks = (t_fork *)(base + head + m->total_philos * sizeof(t_philo_state));
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+	pthread_mutex_init(&pr->shared->mutex, &attr);
+	i = 0;
+	while (i < m->topology.resources)
+		pthread_mutex_init(&forks[i++].mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	procs_point(m, (t_philo_state *)(base + head), forks,
+		(t_stats *)(forks + m->topology.resources));
+	return (0);
+}
+
+/**
+ * Fork one child per group of neighbours, the philosophers split into
+ * 'groups' contiguous ranges. Each child runs procs_child() and never
+ * returns here.
+ *
+ * @return 0 on success, -1 if a child could not be forked.
+ */
+static int	procs_fork(t_monitor *m, t_procs *pr)
+{
+	int		groups;
+	int		first;
+	int		count;
+	pid_t	pid;
+
+	groups = m->opts.workers;
+	if (groups > m->total_philos)
+		groups = m->total_philos;
+	first = 0;
+	while (pr->groups < groups)
+	{
+		count = (m->total_philos - first) / (groups - pr->groups);
+		pid = fork();
+		if (pid == -1)
+			return (-1);
+		if (pid == 0)
+			procs_child(m, first, count);
+		pr->pids[pr->groups++] = pid;
+		first += count;
+	}
+	return (0);
+}
+
+/**
+ * 'procs' engine: run the philosophers in '-j' child processes, one per
+ * group of neighbours, on forks and states in shared memory. The parent
+ * keeps the monitor and the log: relay_main() moves the children's events
+ * into it. The children are set in motion together, see procs_gate().
+ *
+ * @param m Monitor with the table initialized.
+ * @return 0 on success, -1 on failure.
+ */
+int	procs_start(t_monitor *m)
+{
+	t_procs *const	pr = &m->procs;
+
+	engine_fallback(m);
+	pr->states = m->states;
+	pr->forks = m->forks;
+	pr->stats = m->stats;
+	pr->pids = malloc(m->opts.workers * sizeof(pid_t));
+	if (pr->pids == NULL)
+		fprintf(stderr, "error: malloc failure\n");
+	else if (procs_map(m, pr) == -1)
+		fprintf(stderr, "error: mmap failure\n");
+	else if (procs_fork(m, pr) == -1)
+		fprintf(stderr, "error: fork failure\n");
+	else if (pthread_create(&pr->relay, NULL, relay_main, m) != 0)
+		fprintf(stderr, "error: pthread_create failure\n");
+	else
+	{
+		pr->relay_started = true;
+		return (procs_gate(m));
+	}
+	return (-1);
+}
+
+/**
+ * Stop the children and reap them, let the relay pass on what is left in
+ * the ring, and move the table back to its private arrays, copying the
+ * states and histograms the report reads.
+ */
+void	procs_stop(t_monitor *m)
+{
+	t_procs *const	pr = &m->procs;
+
+	if (pr->shared != NULL)
+	{
+		atomic_store(&pr->shared->stop, 1);
+		futex_wake_shared(&pr->shared->stop);
+		futex_wake_shared(&pr->shared->gate);
+		while (pr->groups > 0)
+			waitpid(pr->pids[--pr->groups], NULL, 0);
+		atomic_store(&pr->relay_done, true);
+		futex_wake_shared(&pr->shared->events);
+		if (pr->relay_started)
+			pthread_join(pr->relay, NULL);
+		memcpy(pr->states, m->states, m->total_philos * sizeof(t_philo_state));
+		if (pr->stats != NULL)
+			memcpy(pr->stats, m->stats, m->total_philos * sizeof(t_stats));
+		procs_point(m, pr->states, pr->forks, pr->stats);
+		munmap(pr->shared, pr->size);
+		pr->shared = NULL;
+	}
+	free(pr->pids);
+	pr->pids = NULL;
+}
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   procs_child.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:14:28 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:14:28 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Watcher thread of a child: sleep until the parent raises the shared stop
+ * flag, then stop the child's own run, which wakes its sleepers and opens
+ * its start gate, see stop_broadcast().
+ *
+ * @param arg Monitor of the child.
+ * @return NULL.
+ */
+static void	*child_watch(void *arg)
+{
+	t_monitor *const	m = arg;
+	t_shared *const		sh = m->procs.shared;
+
+	while (atomic_load(&sh->stop) == 0)
+		futex_wait_shared(&sh->stop, 0, 0);
+	set_stop_simulation(m);
+	stop_broadcast(m);
+	return (NULL);
+}
+
+/**
+ * Start gate of a child: once its own philosophers are parked at the gate
+ * of wait_for_start_time(), check in with the parent, wait for the start
+ * time it publishes and open the child's gate with it.
+ *
+ * @param m Monitor of the child, with (ready) counting the others in.
+ */
+static void	child_gate(t_monitor *m)
+{
+	t_shared *const	sh = m->procs.shared;
+	unsigned int	ready;
+
+	ready = atomic_load_explicit(&m->ready, memory_order_acquire);
+	while (ready < (unsigned int)m->total_philos
+		&& atomic_load(&sh->stop) == 0)
+	{
+		futex_wait(&m->ready, ready, current_time() + MONITOR_MAX_SLEEP);
+		ready = atomic_load_explicit(&m->ready, memory_order_acquire);
+	}
+	atomic_fetch_add(&sh->ready, 1);
+	futex_wake_shared(&sh->ready);
+	while (atomic_load(&sh->gate) == 0 && atomic_load(&sh->stop) == 0)
+		futex_wait_shared(&sh->gate, 0, 0);
+	atomic_store_explicit(&m->start_time, atomic_load(&sh->start_time),
+		memory_order_release);
+	atomic_fetch_or_explicit(&m->gate, GATE_OPEN, memory_order_release);
+	futex_wake(&m->gate);
+}
+
+/**
+ * Body of a child process of the 'procs' engine: run the philosophers
+ * 'first' to 'first' + 'count' - 1 as threads, as the 'threads' engine
+ * does, until they are full or the parent stops the run. Their events go
+ * to the parent through relay_push(), and so do those reaching 'must_eat',
+ * see relay_full(). Never returns.
+ *
+ * @param m Monitor inherited from the parent, on the shared table.
+ * @param first Index of the first philosopher of the group.
+ * @param count Philosophers in the group.
+ */
+void	procs_child(t_monitor *m, int first, int count)
+{
+	pthread_t	watcher;
+	int			i;
+
+	m->procs.child = true;
+	atomic_store(&m->ready, m->total_philos - count);
+	if (pthread_create(&watcher, NULL, child_watch, m) != 0)
+		count = 0;
+	i = first;
+	while (i < first + count && pthread_create(&m->philos[i].thread, NULL,
+			philo_main, &m->philos[i]) == 0)
+		m->philos[i++].has_thread = true;
+	if (i < first + count || count == 0)
+	{
+		atomic_store(&m->procs.shared->stop, 1);
+		futex_wake_shared(&m->procs.shared->ready);
+		futex_wake_shared(&m->procs.shared->stop);
+	}
+	child_gate(m);
+	while (i > first)
+		pthread_join(m->philos[--i].thread, NULL);
+	_exit(0);
+}
+
+/**
+ * Start gate of the 'procs' engine on the parent's side: wait until every
+ * child has checked in from child_gate(), then publish the start time as
+ * gate_open() does and open the gate of every child with one wakeup.
+ *
+ * @param m Monitor of the parent, once the children are forked.
+ * @return 0 on success, -1 if a child could not start its philosophers.
+ */
+int	procs_gate(t_monitor *m)
+{
+	t_shared *const	sh = m->procs.shared;
+	unsigned int	ready;
+
+	ready = atomic_load(&sh->ready);
+	while (ready < (unsigned int)m->procs.groups && atomic_load(&sh->stop) == 0)
+	{
+		futex_wait_shared(&sh->ready, ready, 0);
+		ready = atomic_load(&sh->ready);
+	}
+	if (atomic_load(&sh->stop) != 0)
+		return (-1);
+	publish_start_time(m, GATE_MARGIN + GATE_MARGIN_PER_PHILO
+		* (int64_t)m->total_philos);
+	atomic_store(&sh->start_time, atomic_load(&m->start_time));
+	atomic_store(&sh->gate, GATE_OPEN);
+	futex_wake_shared(&sh->gate);
+	return (0);
+}
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   procs_relay.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:12:13 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:12:13 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * log_push() in a child of the 'procs' engine: append the event to the
+ * ring shared with the parent, stamped inside the critical section like
+ * log_push() does, and wake the relay if it sleeps. Waits for room by
+ * yielding, since the relay empties the ring in batches.
+ *
+ * @param m Monitor of the child.
+ * @param id Id of the philosopher.
+ * @param state State enumerator indicating which message to print.
+ */
+void	relay_push(t_monitor *m, int id, enum e_state state)
+{
+	t_shared *const	sh = m->procs.shared;
+	t_event			*event;
+
+	pthread_mutex_lock(&sh->mutex);
+	while (sh->tail - sh->head == LOG_CAPACITY)
+	{
+		pthread_mutex_unlock(&sh->mutex);
+		sched_yield();
+		pthread_mutex_lock(&sh->mutex);
+	}
+	event = &sh->ring[sh->tail & (LOG_CAPACITY - 1)];
+	event->time = sim_time(m) - atomic_load_explicit(&m->start_time,
+			memory_order_relaxed);
+	event->id = id;
+	event->state = state;
+	sh->tail++;
+	pthread_mutex_unlock(&sh->mutex);
+	atomic_fetch_add(&sh->events, 1);
+	if (atomic_load(&sh->relay_idle))
+		futex_wake_shared(&sh->events);
+}
+
+/**
+ * Move up to 'RELAY_BATCH' events from the shared ring to the parent's
+ * log, in order and with the children's timestamps.
+ *
+ * @return Number of events moved.
+ */
+static int	relay_drain(t_monitor *m)
+{
+	t_shared *const	sh = m->procs.shared;
+	t_event			batch[RELAY_BATCH];
+	t_event			*slot;
+	int				count;
+	int				i;
+
+	pthread_mutex_lock(&sh->mutex);
+	count = 0;
+	while (sh->head != sh->tail && count < RELAY_BATCH)
+		batch[count++] = sh->ring[sh->head++ & (LOG_CAPACITY - 1)];
+	pthread_mutex_unlock(&sh->mutex);
+	pthread_mutex_lock(&m->log.mutex);
+	i = 0;
+	while (i < count)
+	{
+		slot = log_slot(&m->log);
+		if (slot == NULL)
+			break ;
+		*slot = batch[i++];
+		log_commit(&m->log, slot);
+	}
+	pthread_mutex_unlock(&m->log.mutex);
+	return (count);
+}
+
+/**
+ * Parent thread of the 'procs' engine: relay the children's events to the
+ * log, and pass on every philosopher the children report full, see
+ * monitor_notify_full(). Sleeps on the shared (events) word when there is
+ * nothing to do, and returns once procs_stop() has reaped the children and
+ * the ring is empty.
+ *
+ * @param arg Monitor of the run.
+ * @return NULL.
+ */
+void	*relay_main(void *arg)
+{
+	t_monitor *const	m = arg;
+	t_shared *const		sh = m->procs.shared;
+	unsigned int		seen;
+	int					full;
+	bool				done;
+
+	full = 0;
+	while (true)
+	{
+		done = atomic_load(&m->procs.relay_done);
+		seen = atomic_load(&sh->events);
+		if (relay_drain(m) > 0)
+			continue ;
+		while (full < atomic_load(&sh->full))
+		{
+			monitor_notify_full(m);
+			full++;
+		}
+		if (done)
+			return (NULL);
+		atomic_store(&sh->relay_idle, 1);
+		futex_wait_shared(&sh->events, seen, current_time()
+			+ MONITOR_MAX_SLEEP);
+		atomic_store(&sh->relay_idle, 0);
+	}
+}
+
+/**
+ * monitor_notify_full() in a child of the 'procs' engine: count the
+ * philosopher on the shared table, where relay_main() passes it on.
+ *
+ * @param m Monitor of the child.
+ */
+void	relay_full(t_monitor *m)
+{
+	atomic_fetch_add(&m->procs.shared->full, 1);
+	atomic_fetch_add(&m->procs.shared->events, 1);
+	futex_wake_shared(&m->procs.shared->events);
+}
@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:40:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:40:33 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Every philosopher starts with the rules of the command line, meals and
+ * sleeps of fixed length, and its own generator, seeded from '-d' and its
+ * id so a seed gives each philosopher the same draws whatever the engine.
+ */
+static void	profile_defaults(t_monitor *m, int args[5])
+{
+	t_philo	*p;
+	int		i;
+
+	i = 0;
+	while (i < m->total_philos)
+	{
+		p = &m->philos[i++];
+		init_rules(&p->rules, args);
+		p->eat.kind = DIST_FIXED;
+		p->eat.low = p->rules.time_to_eat;
+		p->eat.high = p->rules.time_to_eat;
+		p->eat.mean = p->rules.time_to_eat;
+		p->sleep.kind = DIST_FIXED;
+		p->sleep.low = p->rules.time_to_sleep;
+		p->sleep.high = p->rules.time_to_sleep;
+		p->sleep.mean = p->rules.time_to_sleep;
+		prng_seed(&p->rng, ((uint64_t)m->opts.seed << 32) | i);
+	}
+}
+
+/**
+ * (bounds): the longest mean meal and sleep and the shortest 'time_to_die'
+ * of the table, which plan_build() sizes the timetable with.
+ */
+static void	profile_bounds(t_monitor *m)
+{
+	t_rules *const	b = &m->bounds;
+	const t_rules	*r;
+	int				i;
+
+	*b = m->philos[0].rules;
+	i = 1;
+	while (i < m->total_philos)
+	{
+		r = &m->philos[i++].rules;
+		if (r->time_to_die < b->time_to_die)
+			b->time_to_die = r->time_to_die;
+		if (r->time_to_eat > b->time_to_eat)
+			b->time_to_eat = r->time_to_eat;
+		if (r->time_to_sleep > b->time_to_sleep)
+			b->time_to_sleep = r->time_to_sleep;
+	}
+}
+
+/**
+ * Set one rule of philosopher 'p', as parsed by profile_line().
+ *
+ * @param key 0 to 3 for 'die', 'eat', 'sleep' and 'must_eat'.
+ * @param d Value, in microseconds but for 'must_eat'; only 'eat' and
+ * 'sleep' may be drawn from a distribution.
+ */
+void	profile_set(t_philo *p, int key, const t_duration *d)
+{
+	if (key == 0)
+		p->rules.time_to_die = d->mean;
+	else if (key == 1)
+		p->eat = *d;
+	else if (key == 2)
+		p->sleep = *d;
+	else if (d->mean == 0)
+		p->rules.must_eat = INT_MAX;
+	else
+		p->rules.must_eat = d->mean;
+	p->rules.time_to_eat = p->eat.mean;
+	p->rules.time_to_sleep = p->sleep.mean;
+}
+
+/**
+ * Read every line of 'file' with profile_line().
+ *
+ * @return 0 on success, the number of the first invalid line otherwise.
+ */
+static int	profile_lines(t_monitor *m, FILE *file)
+{
+	char	*line;
+	size_t	size;
+	int		number;
+	int		status;
+
+	line = NULL;
+	size = 0;
+	number = 0;
+	status = 0;
+	while (status == 0 && getline(&line, &size, file) != -1)
+	{
+		number++;
+		status = profile_line(m, line);
+	}
+	free(line);
+	if (status == -1)
+		return (number);
+	return (0);
+}
+
+/**
+ * Give every philosopher its own rules: those of the command line, then
+ * with '-P <file>' whatever the file sets, line by line, later lines
+ * winning. Each line selects philosophers ('*', 'odd', 'even', '3' or
+ * '2-5', those past the table are ignored) and sets some of
+ * 'die=<ms>', 'eat=<d>', 'sleep=<d>' and 'must_eat=<n>' (0 for no limit),
+ * with <d> one of '<ms>', 'uniform:<ms>:<ms>' or 'exp:<ms>' (the mean):
+ *   odd   eat=uniform:150:250 sleep=exp:200
+ *   1     die=600 must_eat=0    # never full
+ * Durations are drawn with prng_duration() as the philosopher goes, from
+ * its own generator, so nothing is allocated or shared while it runs.
+ *
+ * @param m Monitor with the philosophers allocated and zeroed.
+ * @param args Parsed arguments, see parse_args().
+ * @return 0 on success, -1 with an error printed otherwise.
+ */
+int	profile_load(t_monitor *m, int args[5])
+{
+	FILE	*file;
+	int		line;
+
+	profile_defaults(m, args);
+	if (m->opts.profile != NULL)
+	{
+		file = fopen(m->opts.profile, "r");
+		if (file == NULL)
+		{
+			perror(m->opts.profile);
+			return (-1);
+		}
+		line = profile_lines(m, file);
+		fclose(file);
+		if (line != 0)
+		{
+			printf("error: %s:%d: invalid profile\n", m->opts.profile, line);
+			return (-1);
+		}
+	}
+	profile_bounds(m);
+	return (0);
+}
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile_parse.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:40:33 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:40:33 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Read a decimal number at '*s' and move past it.
+ *
+ * @return The number, -1 if there is none or it is larger than INT_MAX.
+ */
+static int64_t	scan_number(const char **s)
+{
+	int64_t	n;
+
+	if (**s < '0' || **s > '9')
+		return (-1);
+	n = 0;
+	while (**s >= '0' && **s <= '9' && n <= INT_MAX)
+		n = n * 10 + (*(*s)++ - '0');
+	if (n > INT_MAX)
+		return (-1);
+	return (n);
+}
+
+/**
+ * Parse '<n>', 'uniform:<low>:<high>' or 'exp:<mean>' into 'd', each
+ * number multiplied by 'scale'. A uniform's mean is the middle of its
+ * bounds; an exponential has no bounds, 'high' is left at INT64_MAX.
+ *
+ * @return 0 on success, -1 if 'v' is not one of those.
+ */
+static int	parse_duration(const char *v, t_duration *d, int scale)
+{
+	d->kind = DIST_FIXED;
+	if (strncmp(v, "uniform:", 8) == 0)
+		d->kind = DIST_UNIFORM;
+	else if (strncmp(v, "exp:", 4) == 0)
+		d->kind = DIST_EXP;
+	if (d->kind != DIST_FIXED)
+		v = strchr(v, ':') + 1;
+	d->low = scan_number(&v);
+	d->high = d->low;
+	if (d->kind == DIST_UNIFORM)
+	{
+		if (*v++ != ':')
+			return (-1);
+		d->high = scan_number(&v);
+	}
+	if (*v != '\0' || d->low < 0 || d->high < d->low)
+		return (-1);
+	d->mean = (d->low + d->high) * scale / 2;
+	d->low *= scale;
+	d->high *= scale;
+	if (d->kind == DIST_EXP)
+		d->low = 0;
+	if (d->kind == DIST_EXP)
+		d->high = INT64_MAX;
+	return (0);
+}
+
+/**
+ * Parse which philosophers a line is for into 'range': first and last id,
+ * then the step between them. Ranges are cut at the end of the table.
+ *
+ * @return 0 on success, -1 if 'who' is not a selection.
+ */
+static int	parse_who(const char *who, int range[3], int philos)
+{
+	range[0] = 1;
+	range[1] = philos;
+	range[2] = 1;
+	if (strcmp(who, "*") == 0)
+		return (0);
+	range[2] = 2;
+	if (strcmp(who, "odd") == 0 || strcmp(who, "even") == 0)
+	{
+		range[0] += (who[0] == 'e');
+		return (0);
+	}
+	range[2] = 1;
+	range[0] = scan_number(&who);
+	range[1] = range[0];
+	if (*who == '-')
+	{
+		who++;
+		range[1] = scan_number(&who);
+	}
+	if (*who != '\0' || range[0] < 1 || range[1] < range[0])
+		return (-1);
+	if (range[1] > philos)
+		range[1] = philos;
+	return (0);
+}
+
+/**
+ * Apply one '<key>=<value>' field to the philosophers of 'range', see
+ * profile_set(). 'die' and 'must_eat' take a plain number, and only
+ * 'must_eat' may be 0.
+ *
+ * @return 0 on success, -1 if the field is invalid.
+ */
+static int	profile_field(t_monitor *m, const int range[3], char *field)
+{
+	static const char *const	keys[] = {"die", "eat", "sleep", "must_eat",
+		NULL};
+	char						*value;
+	t_duration					d;
+	int							key;
+	int							i;
+
+	value = strchr(field, '=');
+	if (value == NULL)
+		return (-1);
+	*value++ = '\0';
+	key = 0;
+	while (keys[key] != NULL && strcmp(keys[key], field) != 0)
+		key++;
+	if (keys[key] == NULL || parse_duration(value, &d, 1 + 999 * (key != 3))
+		== -1 || ((key == 0 || key == 3) && d.kind != DIST_FIXED)
+		|| (key != 3 && d.mean <= 0))
+		return (-1);
+	i = range[0];
+	while (i <= range[1])
+	{
+		profile_set(&m->philos[i - 1], key, &d);
+		i += range[2];
+	}
+	return (0);
+}
+
+/**
+ * Parse one line of a '-P' file, see profile_load(): a selection of
+ * philosophers and the fields to set for them. A '#' starts a comment
+ * that runs to the end of the line.
+ *
+ * @param line Line read from the file, modified.
+ * @return 0 on success or for a blank line, -1 if the line is invalid.
+ */
+int	profile_line(t_monitor *m, char *line)
+{
+	char	*save;
+	char	*word;
+	int		range[3];
+
+	line[strcspn(line, "#\r\n")] = '\0';
+	word = strtok_r(line, " \t", &save);
+	if (word == NULL)
+		return (0);
+	if (parse_who(word, range, m->total_philos) == -1)
+		return (-1);
+	word = strtok_r(NULL, " \t", &save);
+	if (word == NULL)
+		return (-1);
+	while (word != NULL)
+	{
+		if (profile_field(m, range, word) == -1)
+			return (-1);
+		word = strtok_r(NULL, " \t", &save);
+	}
+	return (0);
+}
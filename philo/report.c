@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   report.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:51:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:50:39 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Fold every philosopher's counters into one summary. Called after the
+ * philosopher threads have been joined, so plain reads are safe.
+ *
+ * @param m Monitor of the finished run.
+ * @param s Summary to fill.
+ */
+void	report_collect(t_monitor *m, t_summary *s)
+{
+	t_philo_state	*state;
+	int				meals;
+	int				i;
+
+	memset(s, 0, sizeof(*s));
+	s->min_meals = INT_MAX;
+	i = 0;
+	while (i < m->total_philos)
+	{
+		state = &m->states[i++];
+		meals = atomic_load_explicit(&state->has_eaten, memory_order_relaxed);
+		s->meals += meals;
+		s->meals_squared += (double)meals * meals;
+		if (meals < s->min_meals)
+			s->min_meals = meals;
+		if (meals > s->max_meals)
+			s->max_meals = meals;
+		s->total_wait += state->total_wait;
+		if (state->max_wait > s->max_wait)
+			s->max_wait = state->max_wait;
+		if (state->max_hunger > s->max_hunger)
+			s->max_hunger = state->max_hunger;
+	}
+}
+
+/**
+ * Finish the summary line with what the run cost the process and the
+ * children it reaped, the philosophers of 'procs': CPU time in user and
+ * kernel mode, the peak resident set size of the largest of them, which
+ * is where one thread per philosopher shows up against the 'pool' engine,
+ * and the voluntary and involuntary context switches of every thread ('-w'
+ * is meant to cut the former). /proc/self/status only counts the main
+ * thread.
+ */
+static void	report_usage(void)
+{
+	struct rusage	ru;
+	struct rusage	kids;
+	double			user;
+	double			sys;
+
+	getrusage(RUSAGE_SELF, &ru);
+	getrusage(RUSAGE_CHILDREN, &kids);
+	user = ru.ru_utime.tv_sec + kids.ru_utime.tv_sec
+		+ (ru.ru_utime.tv_usec + kids.ru_utime.tv_usec) / 1e6;
+	sys = ru.ru_stime.tv_sec + kids.ru_stime.tv_sec
+		+ (ru.ru_stime.tv_usec + kids.ru_stime.tv_usec) / 1e6;
+	if (kids.ru_maxrss > ru.ru_maxrss)
+		ru.ru_maxrss = kids.ru_maxrss;
+	fprintf(stderr, " cpu_user_s=%.3f cpu_sys_s=%.3f maxrss_kb=%ld "
+		"vol_cs=%ld invol_cs=%ld\n", user, sys, ru.ru_maxrss,
+		ru.ru_nvcsw + kids.ru_nvcsw, ru.ru_nivcsw + kids.ru_nivcsw);
+}
+
+/**
+ * Print a one-line key=value summary of the run to stderr: throughput,
+ * the wait between getting hungry and eating, the longest any philosopher
+ * went without food (the tail that decides survival), and fairness as the
+ * spread of 'has_eaten' and Jain's index (1.0 means every philosopher ate
+ * the same amount), how long the threads took to be joined once the run
+ * was stopped, how long it took to start and to notice a death, followed
+ * by report_usage().
+ *
+ * @param m Monitor of the finished run, see philo_sim_results().
+ */
+void	report_print(t_monitor *m)
+{
+	t_philo_results	r;
+	double			elapsed;
+	double			avg_wait;
+
+	philo_sim_results(m, &r);
+	elapsed = r.elapsed / 1e6;
+	avg_wait = 0;
+	if (r.meals > 0)
+		avg_wait = r.total_wait / 1e3 / r.meals;
+	fprintf(stderr, "engine=%s strategy=%s philos=%d elapsed_s=%.3f "
+		"meals=%ld meals_per_s=%.1f avg_wait_ms=%.3f max_wait_ms=%.3f "
+		"max_hunger_ms=%.3f meals_min=%d meals_max=%d fairness=%.4f "
+		"stop_ms=%.3f startup_ms=%.3f detect_ms=%.3f", m->opts.engine->name,
+		m->opts.strategy->name, m->total_philos, elapsed, (long)r.meals,
+		r.meals / elapsed, avg_wait, r.max_wait / 1e3, r.max_hunger / 1e3,
+		r.meals_min, r.meals_max, r.fairness, r.stop_latency / 1e3,
+		r.startup / 1e3, r.detect_latency / 1e3);
+	report_usage();
+}
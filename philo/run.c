@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   run.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:07:37 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:32:24 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Free memory allocated to philosophers, forks, their state, the topology,
+ * the deadline heaps, the monitor shards and the histograms.
+ *
+ * @param m Monitor whose resources should be freed.
+ * @return -1 always.
+ */
+int	run_free(t_monitor *m)
+{
+	if (m->forks)
+		free(m->forks);
+	if (m->philos)
+		free(m->philos);
+	if (m->deadlines)
+		free(m->deadlines);
+	if (m->states)
+		free(m->states);
+	if (m->stats)
+		free(m->stats);
+	if (m->shards)
+		free(m->shards);
+	if (m->stats_json)
+		fclose(m->stats_json);
+	topology_free(&m->topology);
+	return (-1);
+}
+
+/**
+ * Build the topology, see topology_build(), and allocate the philosophers,
+ * one fork per resource, the monitor's deadline heaps and its shards, see
+ * monitor_shards(). Every philosopher then gets its rules, see
+ * profile_load().
+ * Forks and hot state are cache-line aligned, see 't_fork' and
+ * 't_philo_state'. Forks, philosophers and states start zeroed, which is
+ * the initial state of every strategy's fork fields. On failure the caller
+ * still owns whatever was allocated, see run_free().
+ *
+ * @param m Monitor with 'total_philos' set.
+ * @param args Parsed arguments, see parse_args().
+ * @return 0 on success, -1 on allocation failure or an invalid '-P' file.
+ */
+static int	run_alloc(t_monitor *m, int args[5])
+{
+	if (topology_build(m) == -1)
+		return (-1);
+	m->forks = aligned_alloc(CACHE_LINE,
+			m->topology.resources * sizeof(t_fork));
+	m->states = aligned_alloc(CACHE_LINE,
+			m->total_philos * sizeof(t_philo_state));
+	m->philos = malloc(m->total_philos * sizeof(t_philo));
+	m->deadlines = malloc(m->total_philos * sizeof(t_deadline));
+	m->shard_count = monitor_shards(m);
+	m->shards = malloc(m->shard_count * sizeof(t_shard));
+	if (m->forks == NULL || m->states == NULL || m->philos == NULL
+		|| m->deadlines == NULL || m->shards == NULL)
+		return (-1);
+	memset(m->forks, 0, m->topology.resources * sizeof(t_fork));
+	memset(m->philos, 0, m->total_philos * sizeof(t_philo));
+	memset(m->states, 0, m->total_philos * sizeof(t_philo_state));
+	return (profile_load(m, args));
+}
+
+/**
+ * Run one simulation to its end: allocate the table, start the monitor and
+ * the philosophers, and run the monitor loop until a philosopher dies or
+ * everyone reached 'must_eat'. The figures of the run (the philosopher
+ * states and histograms) stay readable until run_free().
+ *
+ * @param m Zeroed monitor with its options set.
+ * @param args Parsed arguments, see parse_args().
+ * @return 0 once the run is over, -1 if it could not be started or an
+ * output file could not be written.
+ */
+int	run_simulation(t_monitor *m, int args[5])
+{
+	m->total_philos = args[0];
+	if (run_alloc(m, args) == -1)
+		return (-1);
+	if (start_monitor(m, args) == -1)
+	{
+		stop_monitor(m);
+		return (-1);
+	}
+	loop_monitor(m);
+	return (stop_monitor(m));
+}
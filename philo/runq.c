@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   runq.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:08:19 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Initialize an empty run queue that can hold 'capacity' ids. The lock is
+ * initialized even when the allocation fails, so runq_destroy() is always
+ * safe to call.
+ *
+ * @param q Queue to initialize.
+ * @param capacity Maximum number of queued ids.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int	runq_init(t_runq *q, int capacity)
+{
+	pthread_mutex_init(&q->mutex, NULL);
+	pthread_cond_init(&q->not_empty, NULL);
+	q->capacity = capacity;
+	q->head = 0;
+	q->count = 0;
+	q->closed = false;
+	q->items = malloc(capacity * sizeof(int));
+	if (q->items == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Append 'id' and wake one worker. Each philosopher is queued at most once
+ * at a time, so the queue never overflows.
+ */
+void	runq_push(t_runq *q, int id)
+{
+	pthread_mutex_lock(&q->mutex);
+	q->items[(q->head + q->count) % q->capacity] = id;
+	q->count++;
+	pthread_cond_signal(&q->not_empty);
+	pthread_mutex_unlock(&q->mutex);
+}
+
+/**
+ * Take the oldest id, waiting while the queue is empty.
+ *
+ * @param q Queue to pop from.
+ * @return The id, or -1 once the queue is closed.
+ */
+int	runq_pop(t_runq *q)
+{
+	int	id;
+
+	id = -1;
+	pthread_mutex_lock(&q->mutex);
+	while (q->count == 0 && q->closed == false)
+		pthread_cond_wait(&q->not_empty, &q->mutex);
+	if (q->closed == false)
+	{
+		id = q->items[q->head];
+		q->head = (q->head + 1) % q->capacity;
+		q->count--;
+	}
+	pthread_mutex_unlock(&q->mutex);
+	return (id);
+}
+
+/**
+ * Make every current and future runq_pop() return -1.
+ */
+void	runq_close(t_runq *q)
+{
+	pthread_mutex_lock(&q->mutex);
+	q->closed = true;
+	pthread_cond_broadcast(&q->not_empty);
+	pthread_mutex_unlock(&q->mutex);
+}
+
+/**
+ * Free what runq_init() created.
+ */
+void	runq_destroy(t_runq *q)
+{
+	free(q->items);
+	pthread_cond_destroy(&q->not_empty);
+	pthread_mutex_destroy(&q->mutex);
+}
@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   schedule.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:49:26 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Look up a think policy by the name given to '-p'.
+ *
+ * @param name Policy name.
+ * @return Matching policy, or NULL if there is none.
+ */
+const t_policy	*policy_find(const char *name)
+{
+	static const t_policy	policies[] = {
+	{"fixed", stagger_delay, think_time, false},
+	{"adaptive", plan_stagger, adaptive_think, false},
+	{"planned", plan_stagger, plan_think, true},
+	{NULL, NULL, NULL, false},
+	};
+	int						i;
+
+	i = 0;
+	while (policies[i].name != NULL)
+	{
+		if (strcmp(policies[i].name, name) == 0)
+			return (&policies[i]);
+		i++;
+	}
+	return (NULL);
+}
+
+/**
+ * 'fixed': how long an odd philosopher holds back at the start: half the
+ * first meal of its slower neighbour, or all of it when the table is large.
+ * Off a ring, where philo_left() and philo_right() are not the neighbours,
+ * its own meal stands in for theirs. Even philosophers start right away.
+ *
+ * @param p Philosopher starting.
+ * @return Delay after 'start_time' in microseconds.
+ */
+int64_t	stagger_delay(t_philo *p)
+{
+	int64_t	meal;
+
+	if (p->id % 2 == 0)
+		return (0);
+	meal = p->rules.time_to_eat;
+	if (p->monitor->topology.ring)
+	{
+		meal = philo_left(p)->rules.time_to_eat;
+		if (philo_right(p)->rules.time_to_eat > meal)
+			meal = philo_right(p)->rules.time_to_eat;
+	}
+	if (p->monitor->total_philos > 100)
+		return (meal);
+	return (meal / 2);
+}
+
+/**
+ * Delays the starting time as the '-p' policy says, see stagger_delay().
+ */
+void	stagger_starting_times(t_philo *p)
+{
+	wait_until(p, get_start_time(p) + p->monitor->opts.policy->stagger(p));
+}
+
+/**
+ * 'fixed': how long to think to retain the stagger set with stagger_delay(),
+ * from the philosopher's own rules, with '-P' its mean meal and sleep.
+ * Philosophers think for at least 'min_time_to_think' amount of time;
+ * unless time left before the philosopher must eat to avoid dying is less than
+ * the minimum.
+ * 
+ * When total_philos == even || min is set to 25% of slack
+ * When total_philos == odd  || min is set to 75% of slack
+ * 
+ * @param p Philosopher thinking.
+ * @param now Current time in microseconds.
+ * @return Time to think in microseconds, 0 when there is no time to spare.
+ */
+int64_t	think_time(t_philo *p, int64_t now)
+{
+	const t_rules *const	r = &p->rules;
+	int64_t					slack;
+	int64_t					min_time_to_think;
+	int64_t					time_left;
+
+	slack = r->time_to_die - r->time_to_eat - r->time_to_sleep;
+	if (slack <= 0)
+		return (0);
+	min_time_to_think = slack / 4;
+	if (p->monitor->total_philos % 2 != 0)
+		min_time_to_think = slack - (slack / 4);
+	time_left = r->time_to_die - (now - get_last_ate(p)) - r->time_to_eat;
+	if (time_left <= 0)
+		return (0);
+	if (min_time_to_think > time_left)
+		return (time_left);
+	return (min_time_to_think);
+}
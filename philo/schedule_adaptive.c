@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   schedule_adaptive.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 06:33:44 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:02:13 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Until when 'p' should leave the fork it shares with neighbour 'n' alone:
+ * if 'n' last ate before 'p' it is closer to death, and it is hungry,
+ * since it has slept as long as 'p' has. It can eat as soon as its
+ * neighbour on the other side is done with their fork, expected after that
+ * neighbour's own mean meal, which gives the time to yield until.
+ *
+ * @param p Philosopher about to think.
+ * @param n Neighbour of 'p'.
+ * @param now Current time in microseconds.
+ * @return Time to think until for the sake of 'n', 'now' for none.
+ */
+static int64_t	yield_until(t_philo *p, t_philo *n, int64_t now)
+{
+	t_philo	*beyond;
+	int64_t	ate;
+	int64_t	meal;
+
+	if (get_last_ate(n) > get_last_ate(p) || get_has_eaten(n)
+		>= n->rules.must_eat)
+		return (now);
+	beyond = philo_right(n);
+	if (n == philo_left(p))
+		beyond = philo_left(n);
+	ate = get_last_ate(beyond);
+	meal = beyond->rules.time_to_eat;
+	if (ate <= now && ate + meal > now)
+		return (ate + meal + THINK_DELAY);
+	return (now + THINK_DELAY);
+}
+
+/**
+ * 'adaptive': think until the philosopher's next meal of the timetable,
+ * see plan_think(), and for as long as a neighbour closer to death still
+ * needs a shared fork, see yield_until(). The deadlines are read live from
+ * 'last_ate', which lets the table recover from a late thread instead of
+ * passing the delay on, but a philosopher never thinks past 'THINK_MARGIN'
+ * before its own death.
+ *
+ * @param p Philosopher thinking.
+ * @param now Current time in microseconds.
+ * @return Time to think in microseconds, 0 to reach for the forks now.
+ */
+int64_t	adaptive_think(t_philo *p, int64_t now)
+{
+	int64_t	until;
+	int64_t	yield;
+	int64_t	latest;
+
+	until = now + plan_think(p, now);
+	yield = yield_until(p, philo_left(p), now);
+	if (yield > until)
+		until = yield;
+	yield = yield_until(p, philo_right(p), now);
+	if (yield > until)
+		until = yield;
+	latest = get_last_ate(p) + p->rules.time_to_die - THINK_MARGIN;
+	if (until > latest)
+		until = latest;
+	if (until <= now)
+		return (0);
+	return (until - now);
+}
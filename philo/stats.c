@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:53:16 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:32:24 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * With 'opts.histograms' ('-H', '-J', philo_bench), allocate one zeroed set
+ * of histograms per philosopher, and open the '-J' file. Left NULL
+ * otherwise, which turns every stats_*() call into a no-op.
+ *
+ * @param m Monitor with 'total_philos' set.
+ * @return 0 on success, -1 on allocation failure or an unwritable '-J' file.
+ */
+int	stats_start(t_monitor *m)
+{
+	if (m->opts.histograms == false)
+		return (0);
+	m->stats = aligned_alloc(CACHE_LINE, m->total_philos * sizeof(t_stats));
+	if (m->stats == NULL)
+		return (-1);
+	memset(m->stats, 0, m->total_philos * sizeof(t_stats));
+	if (m->opts.stats_file != NULL)
+		m->stats_json = stats_open_json(m);
+	if (m->opts.stats_file != NULL && m->stats_json == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Record one sample of 'kind' for philosopher 'p'. Only the thread running
+ * 'p' calls this, so the histogram is written without any synchronization.
+ *
+ * @param p Philosopher the sample belongs to.
+ * @param kind enum e_stat.
+ * @param value Sample in microseconds.
+ */
+void	stats_record(t_philo *p, int kind, int64_t value)
+{
+	if (p->monitor->stats == NULL)
+		return ;
+	hist_record(&p->monitor->stats[p->id - 1].hist[kind], value);
+}
+
+/**
+ * Lock a fork or waiter mutex on behalf of 'p', recording how long it was
+ * blocked. An uncontended trylock counts as 0, so the histogram also shows
+ * how often the lock was contended at all.
+ *
+ * @param p Philosopher taking the lock.
+ * @param mutex Mutex to lock.
+ */
+void	stats_lock(t_philo *p, pthread_mutex_t *mutex)
+{
+	int64_t	blocked_since;
+
+	if (p->monitor->stats == NULL)
+	{
+		pthread_mutex_lock(mutex);
+		return ;
+	}
+	if (pthread_mutex_trylock(mutex) == 0)
+	{
+		stats_record(p, STAT_LOCK_WAIT, 0);
+		return ;
+	}
+	blocked_since = current_time();
+	pthread_mutex_lock(mutex);
+	stats_record(p, STAT_LOCK_WAIT, current_time() - blocked_since);
+}
+
+/**
+ * philo_step() counterpart of the oversleep measured in wait_until(): how
+ * late a step runs after the time it was due. 'wake_at' is cleared so that
+ * a philosopher woken by a fork handoff, which was not waiting for a time,
+ * is not counted.
+ *
+ * @param p Philosopher being stepped.
+ * @param now Time the step runs at.
+ */
+void	stats_wakeup(t_philo *p, int64_t now)
+{
+	if (p->wake_at > 0)
+		stats_record(p, STAT_OVERSLEEP, now - p->wake_at);
+	p->wake_at = 0;
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_json.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:53:16 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:32:24 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Write the figures of 'h' as the body of a JSON object, in microseconds.
+ */
+static void	json_summary(FILE *f, const t_hist *h)
+{
+	double	mean;
+
+	mean = 0;
+	if (h->count > 0)
+		mean = (double)h->sum / h->count;
+	fprintf(f, "\"count\": %ld, \"mean\": %.1f, \"min\": %ld, \"p50\": %ld, "
+		"\"p90\": %ld, \"p99\": %ld, \"p999\": %ld, \"max\": %ld",
+		(long)h->count, mean, (long)h->min, (long)hist_percentile(h, 0.5),
+		(long)hist_percentile(h, 0.9), (long)hist_percentile(h, 0.99),
+		(long)hist_percentile(h, 0.999), (long)h->max);
+}
+
+/**
+ * Write the non-empty buckets of 'h' as [upper bound, count] pairs.
+ */
+static void	json_buckets(FILE *f, const t_hist *h)
+{
+	const char	*sep;
+	int			i;
+
+	fprintf(f, ", \"buckets\": [");
+	sep = "";
+	i = 0;
+	while (i < HIST_BUCKETS)
+	{
+		if (h->buckets[i] != 0)
+		{
+			fprintf(f, "%s[%ld, %u]", sep, (long)hist_bucket_value(i),
+				h->buckets[i]);
+			sep = ", ";
+		}
+		i++;
+	}
+	fprintf(f, "]");
+}
+
+/**
+ * Write one object holding a summary per measurement, with the buckets
+ * when 'buckets' is true.
+ */
+static void	json_kinds(FILE *f, const t_hist *hist, bool buckets)
+{
+	int	kind;
+
+	kind = 0;
+	while (kind < STAT_KINDS)
+	{
+		if (kind != 0)
+			fprintf(f, ", ");
+		fprintf(f, "\"%s\": {", stats_name(kind));
+		json_summary(f, &hist[kind]);
+		if (buckets)
+			json_buckets(f, &hist[kind]);
+		fprintf(f, "}");
+		kind++;
+	}
+}
+
+/**
+ * Open the '-J' file for writing and start the JSON object. It is opened
+ * before the run, see stats_start(), so a file that cannot be written
+ * fails the run as '-t' and '-L' do.
+ *
+ * @return The open file, NULL (with an error on stderr) if it can't be opened.
+ */
+FILE	*stats_open_json(t_monitor *m)
+{
+	FILE	*f;
+
+	f = fopen(m->opts.stats_file, "w");
+	if (f == NULL)
+	{
+		fprintf(stderr, "error: cannot write %s\n", m->opts.stats_file);
+		return (NULL);
+	}
+	fprintf(f, "{\"engine\": \"%s\", \"strategy\": \"%s\", \"philos\": %d, "
+		"\"unit\": \"us\",\n", m->opts.engine->name, m->opts.strategy->name,
+		m->total_philos);
+	return (f);
+}
+
+/**
+ * '-J <file>': write the merged histograms, with their buckets, and a
+ * summary per philosopher as JSON to the file from stats_open_json(), and
+ * close it. All values are in microseconds.
+ *
+ * @param m Monitor of the finished run, with 'stats_json' open.
+ * @param total Histograms merged over every philosopher.
+ * @return 0 on success, -1 (with an error on stderr) if a write failed.
+ */
+int	stats_write_json(t_monitor *m, const t_hist total[STAT_KINDS])
+{
+	FILE *const	f = m->stats_json;
+	int			i;
+
+	m->stats_json = NULL;
+	fprintf(f, " \"total\": {");
+	json_kinds(f, total, true);
+	fprintf(f, "},\n \"per_philo\": [");
+	i = 0;
+	while (i < m->total_philos)
+	{
+		if (i != 0)
+			fprintf(f, ",");
+		fprintf(f, "\n  {\"id\": %d, ", i + 1);
+		json_kinds(f, m->stats[i].hist, false);
+		fprintf(f, "}");
+		i++;
+	}
+	fprintf(f, "]}\n");
+	if ((ferror(f) | fclose(f)) != 0)
+	{
+		fprintf(stderr, "error: cannot write %s\n", m->opts.stats_file);
+		return (-1);
+	}
+	return (0);
+}
@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:53:16 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:32:24 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return Name of measurement 'kind' (enum e_stat) in the summary and JSON.
+ */
+const char	*stats_name(int kind)
+{
+	static const char	*names[STAT_KINDS] = {
+		"fork_wait",
+		"eat_margin",
+		"oversleep",
+		"lock_wait",
+	};
+
+	return (names[kind]);
+}
+
+/**
+ * Merge the histograms of every philosopher into 'total', one per
+ * measurement.
+ *
+ * @param m Monitor of the finished run, with 'stats' allocated.
+ * @param total Histograms to fill.
+ */
+void	stats_merge(t_monitor *m, t_hist total[STAT_KINDS])
+{
+	int	i;
+	int	kind;
+
+	memset(total, 0, STAT_KINDS * sizeof(t_hist));
+	i = 0;
+	while (i < m->total_philos)
+	{
+		kind = 0;
+		while (kind < STAT_KINDS)
+		{
+			hist_merge(&total[kind], &m->stats[i].hist[kind]);
+			kind++;
+		}
+		i++;
+	}
+}
+
+/**
+ * Print one key=value line for a merged histogram, in milliseconds like
+ * report_print().
+ */
+static void	print_hist(int kind, const t_hist *h)
+{
+	double	mean;
+
+	mean = 0;
+	if (h->count > 0)
+		mean = (double)h->sum / h->count;
+	fprintf(stderr, "stat=%s count=%ld mean_ms=%.3f min_ms=%.3f p50_ms=%.3f "
+		"p90_ms=%.3f p99_ms=%.3f p999_ms=%.3f max_ms=%.3f\n",
+		stats_name(kind), (long)h->count, mean / 1e3, h->min / 1e3,
+		hist_percentile(h, 0.5) / 1e3, hist_percentile(h, 0.9) / 1e3,
+		hist_percentile(h, 0.99) / 1e3, hist_percentile(h, 0.999) / 1e3,
+		h->max / 1e3);
+}
+
+/**
+ * Merge the per-philosopher histograms once the engine has stopped and
+ * report them: one line per measurement on stderr with '-H', the full
+ * histograms in a JSON file with '-J'. The measurements are
+ *  fork_wait   hungry to holding both forks (see record_wait())
+ *  eat_margin  time left before 'time_to_die' when a meal starts
+ *  oversleep   how late a timed wait returned
+ *  lock_wait   time blocked on a fork or waiter mutex
+ *
+ * @param m Monitor of the finished run, with 'stats' allocated.
+ * @return 0 on success, -1 if the '-J' file could not be written.
+ */
+int	stats_report(t_monitor *m)
+{
+	t_hist	total[STAT_KINDS];
+	int		kind;
+
+	if (m->stats == NULL)
+		return (0);
+	stats_merge(m, total);
+	kind = 0;
+	while (m->opts.stats && kind < STAT_KINDS)
+	{
+		print_hist(kind, &total[kind]);
+		kind++;
+	}
+	if (m->stats_json != NULL)
+		return (stats_write_json(m, total));
+	return (0);
+}
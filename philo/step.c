@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   step.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Hold back for the start stagger. A lone philosopher goes straight for
+ * its only fork and is left parked there until the monitor sees it die.
+ */
+static int64_t	step_start(t_philo *p)
+{
+	if (p->lone)
+	{
+		p->phase = PHASE_HUNGRY;
+		return (get_start_time(p));
+	}
+	p->phase = PHASE_THINK;
+	return (get_start_time(p) + p->monitor->opts.policy->stagger(p));
+}
+
+/**
+ * Print the thinking event and think as long as the '-p' policy says,
+ * skipped before the first meal like in philo_main().
+ */
+static int64_t	step_think(t_philo *p, int64_t now)
+{
+	int64_t	think;
+
+	philo_print(p, THINKING);
+	think = 0;
+	if (get_has_eaten(p) != 0)
+		think = p->monitor->opts.policy->think(p, now);
+	p->phase = PHASE_HUNGRY;
+	p->hungry_since = now + think;
+	return (now + think);
+}
+
+/**
+ * Start eating. The meal is timed from 'last_ate', which is taken after the
+ * event is printed, as in eat_and_check_saturation().
+ */
+static int64_t	step_eat(t_philo *p)
+{
+	meal_begin(p);
+	p->phase = PHASE_REST;
+	return (get_last_ate(p) + prng_duration(&p->rng, &p->eat));
+}
+
+/**
+ * Finish the meal, then sleep unless the philosopher is full.
+ */
+static int64_t	step_rest(t_philo *p)
+{
+	step_put_forks(p);
+	if (meal_end(p) == FULL)
+		return (STEP_DONE);
+	philo_print(p, SLEEPING);
+	p->phase = PHASE_THINK;
+	return (sim_time(p->monitor) + prng_duration(&p->rng, &p->sleep));
+}
+
+/**
+ * Run philosopher 'p' as a state machine, mirroring one pass through
+ * philo_main(): start, think, take forks, eat, sleep. Phases follow each
+ * other until one has to wait for a time to come or for a fork to be
+ * handed over. A timer that fires before 'wake_at' (see wheel_insert())
+ * only re-arms it.
+ *
+ * @param p Philosopher to advance; only one worker runs it at a time.
+ * @param now Current time in microseconds.
+ * @return Time the next step is due, 'STEP_PARKED' while waiting for a
+ * fork, or 'STEP_DONE' once the philosopher is full or the run has stopped.
+ */
+int64_t	philo_step(t_philo *p, int64_t now)
+{
+	int64_t	when;
+
+	if (now < p->wake_at)
+		return (p->wake_at);
+	stats_wakeup(p, now);
+	when = now;
+	while (when >= 0 && when <= now)
+	{
+		if (get_stop_simulation(p))
+			return (STEP_DONE);
+		if (p->phase == PHASE_START)
+			when = step_start(p);
+		else if (p->phase == PHASE_THINK)
+			when = step_think(p, now);
+		else if (p->phase == PHASE_HUNGRY)
+			when = step_take_forks(p, now);
+		else if (p->phase == PHASE_EAT)
+			when = step_eat(p);
+		else
+			when = step_rest(p);
+	}
+	if (when >= 0)
+		p->wake_at = when;
+	return (when);
+}
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   step_forks.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:49:00 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Take 'f' if it is free or was handed over to 'p' by step_put_forks();
+ * otherwise queue 'p' on it. Off a ring a fork may have more than one
+ * philosopher waiting, so they are handed it in the order they came. The
+ * fork's mutex is only held for the check, never while eating.
+ *
+ * @return true if 'p' now holds the fork.
+ */
+static bool	grab_fork(t_philo *p, t_fork *f)
+{
+	const int	idx = p->id - 1;
+	bool		got;
+
+	stats_lock(p, &f->mutex);
+	if (f->holder == -1)
+		f->holder = idx;
+	got = (f->holder == idx);
+	if (got == false)
+	{
+		p->parked_next = -1;
+		if (f->parked == -1)
+			f->parked = idx;
+		else
+			p->monitor->philos[f->parked_last].parked_next = idx;
+		f->parked_last = idx;
+	}
+	pthread_mutex_unlock(&f->mutex);
+	return (got);
+}
+
+/**
+ * Give 'f' straight to the first philosopher queued on it, if any, and make
+ * that philosopher runnable again.
+ */
+static void	release_fork(t_philo *p, t_fork *f)
+{
+	int	next;
+
+	stats_lock(p, &f->mutex);
+	next = f->parked;
+	f->holder = next;
+	if (next != -1)
+		f->parked = p->monitor->philos[next].parked_next;
+	pthread_mutex_unlock(&f->mutex);
+	if (next != -1)
+		p->monitor->opts.engine->wake(p->monitor, next);
+}
+
+/**
+ * Non-blocking counterpart of ordered_take(): take the forks of the
+ * philosopher's row of the topology in order, parking on the first one
+ * that is busy. A parked philosopher keeps the forks it already holds,
+ * exactly like a thread blocked on a later mutex, and resumes here when
+ * the fork is handed over. Once it returns 'STEP_PARKED' the philosopher
+ * belongs to whoever wakes it, so nothing in 'p' may be touched afterwards.
+ * A lone philosopher parks for good on the fork it has, if any.
+ *
+ * @param p Philosopher taking the forks.
+ * @param now Current time in microseconds.
+ * @return 'now' once every fork is held, 'STEP_PARKED' otherwise.
+ */
+int64_t	step_take_forks(t_philo *p, int64_t now)
+{
+	t_fork *const	forks = p->monitor->forks;
+
+	while (p->forks_held < p->need_count)
+	{
+		if (grab_fork(p, &forks[p->needs[p->forks_held]]) == false)
+			return (STEP_PARKED);
+		philo_print(p, TOOK_FORK);
+		p->forks_held++;
+	}
+	if (p->lone)
+		return (STEP_PARKED);
+	record_wait(p, now - p->hungry_since);
+	p->phase = PHASE_EAT;
+	return (now);
+}
+
+/**
+ * Put every fork back, handing each to the neighbour parked on it.
+ *
+ * @param p Philosopher done eating.
+ */
+void	step_put_forks(t_philo *p)
+{
+	while (p->forks_held > 0)
+		release_fork(p, &p->monitor->forks[p->needs[--p->forks_held]]);
+}
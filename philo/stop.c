@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stop.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:59:01 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:29:43 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Sleep until the absolute time 'target_time', or until the run is stopped.
+ * The stop flag is the futex word: stop_broadcast() wakes every sleeper at
+ * once, so waits no longer need to be cut into slices to notice a stop.
+ * The deadline is absolute on the clock of current_time(), so an early
+ * wakeup or a late-scheduled sleep never accumulates drift.
+ *
+ * @param m Monitor owning the stop flag.
+ * @param target_time Absolute time in microseconds.
+ */
+void	stop_sleep_until(t_monitor *m, int64_t target_time)
+{
+	while (atomic_load_explicit(&m->stop_simulation, memory_order_acquire) == 0
+		&& current_time() < target_time)
+		futex_wait(&m->stop_simulation, 0, target_time);
+}
+
+/**
+ * Wake every thread in stop_sleep_until() with one system call, and open
+ * the start gate for the philosophers still waiting at it. Once the run
+ * has started, the strategy also wakes the philosophers blocked in its
+ * 'take': a fork that is never put down (its holder died, or the forks
+ * were never free) would otherwise keep them waiting forever. A
+ * philosopher blocked on a plain fork mutex needs no wake: the holder
+ * sleeps through its meal, wakes here and puts the fork down.
+ *
+ * @param m Monitor whose stop flag is raised.
+ */
+void	stop_broadcast(t_monitor *m)
+{
+	atomic_fetch_or_explicit(&m->gate, GATE_STOPPED, memory_order_release);
+	futex_wake(&m->gate);
+	futex_wake(&m->stop_simulation);
+	if (m->opts.strategy->wake != NULL
+		&& atomic_load_explicit(&m->start_time, memory_order_acquire) != 0)
+		m->opts.strategy->wake(m);
+}
+
+/**
+ * Stop wake of the strategies waiting on a fork's condition ('chandy',
+ * 'ticket'): broadcast every fork under its mutex, so a waiter that just
+ * found the stop flag clear is already waiting and cannot miss it.
+ *
+ * @param m Monitor whose stop flag is raised.
+ */
+void	stop_wake_forks(t_monitor *m)
+{
+	int	i;
+
+	i = 0;
+	while (i < m->topology.resources)
+	{
+		pthread_mutex_lock(&m->forks[i].mutex);
+		pthread_cond_broadcast(&m->forks[i].cond);
+		pthread_mutex_unlock(&m->forks[i].mutex);
+		i++;
+	}
+}
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:51:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:29:43 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Look up a fork-acquisition strategy by the name given to '-s'.
+ *
+ * @param name Strategy name.
+ * @return Matching strategy, or NULL if there is none.
+ */
+const t_strategy	*strategy_find(const char *name)
+{
+	static const t_strategy	strategies[] = {
+	{"ordered", NULL, ordered_take, ordered_put, NULL},
+	{"chandy", chandy_init, chandy_take, chandy_put, stop_wake_forks},
+	{"waiter", NULL, waiter_take, waiter_put, waiter_wake},
+	{"trylock", NULL, trylock_take, ordered_put, NULL},
+	{"ticket", NULL, ticket_take, ticket_put, stop_wake_forks},
+	{NULL, NULL, NULL, NULL, NULL},
+	};
+	int						i;
+
+	i = 0;
+	while (strategies[i].name != NULL)
+	{
+		if (strcmp(strategies[i].name, name) == 0)
+			return (&strategies[i]);
+		i++;
+	}
+	return (NULL);
+}
+
+/**
+ * Initialize the synchronization every strategy may use, then let the
+ * selected strategy set up its own state. Philosophers must already be
+ * initialized, since strategies refer to their neighbours.
+ *
+ * @param m Monitor owning the forks and philosophers.
+ */
+void	strategy_init(t_monitor *m)
+{
+	int	i;
+
+	pthread_mutex_init(&m->waiter.mutex, NULL);
+	i = 0;
+	while (i < m->topology.resources)
+	{
+		pthread_mutex_init(&m->forks[i].mutex, NULL);
+		pthread_cond_init(&m->forks[i].cond, NULL);
+		m->forks[i].next_ticket = 0;
+		m->forks[i].now_serving = 0;
+		m->forks[i].holder = -1;
+		m->forks[i].parked_last = -1;
+		m->forks[i++].parked = -1;
+	}
+	i = 0;
+	while (i < m->total_philos)
+	{
+		pthread_cond_init(&m->philos[i].turn, NULL);
+		sem_init(&m->philos[i].wakeup, 0, 0);
+		i++;
+	}
+	if (m->opts.strategy->init != NULL)
+		m->opts.strategy->init(m);
+}
+
+/**
+ * Destroy what strategy_init() created.
+ *
+ * @param m Monitor owning the forks and philosophers.
+ */
+void	strategy_destroy(t_monitor *m)
+{
+	int	i;
+
+	i = 0;
+	while (i < m->topology.resources)
+	{
+		pthread_mutex_destroy(&m->forks[i].mutex);
+		pthread_cond_destroy(&m->forks[i++].cond);
+	}
+	i = 0;
+	while (i < m->total_philos)
+	{
+		pthread_cond_destroy(&m->philos[i].turn);
+		sem_destroy(&m->philos[i].wakeup);
+		i++;
+	}
+	pthread_mutex_destroy(&m->waiter.mutex);
+}
+
+/**
+ * @return The philosopher sharing 'p->fork1'.
+ */
+t_philo	*philo_left(t_philo *p)
+{
+	t_monitor *const	m = p->monitor;
+
+	return (&m->philos[(p->id - 2 + m->total_philos) % m->total_philos]);
+}
+
+/**
+ * @return The philosopher sharing 'p->fork2'.
+ */
+t_philo	*philo_right(t_philo *p)
+{
+	t_monitor *const	m = p->monitor;
+
+	return (&m->philos[p->id % m->total_philos]);
+}
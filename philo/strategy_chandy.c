@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_chandy.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:51:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:29:43 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Chandy/Misra initial state: every fork is dirty and held by the
+ * lower-indexed of the two philosophers sharing it, which makes the
+ * precedence graph acyclic.
+ *
+ * @param m Monitor owning the forks.
+ */
+void	chandy_init(t_monitor *m)
+{
+	int	i;
+
+	i = 0;
+	while (i < m->total_philos)
+	{
+		m->forks[i].owner = i - 1;
+		if (i == 0)
+			m->forks[i].owner = 0;
+		m->forks[i].dirty = true;
+		m->forks[i].busy = false;
+		i++;
+	}
+}
+
+/**
+ * Request one fork and wait until we own it or the run stops, see
+ * stop_wake_forks(). The request is served as soon
+ * as the holder's copy is dirty and not being eaten with: the fork is then
+ * cleaned and changes hands. A clean fork stays with a hungry holder until
+ * it has eaten.
+ *
+ * @param p Philosopher requesting the fork.
+ * @param f Fork requested.
+ */
+static void	request_fork(t_philo *p, t_fork *f)
+{
+	stats_lock(p, &f->mutex);
+	while (f->owner != p->id - 1 && get_stop_simulation(p) == false)
+	{
+		if (f->dirty == true && f->busy == false)
+		{
+			f->owner = p->id - 1;
+			f->dirty = false;
+		}
+		else
+			pthread_cond_wait(&f->cond, &f->mutex);
+	}
+	pthread_mutex_unlock(&f->mutex);
+}
+
+/**
+ * Atomically check that both forks are still ours and mark them as being
+ * eaten with. A dirty fork may have been handed to a neighbour while we
+ * were waiting for the other one. Forks are locked in address order.
+ *
+ * @return true if the philosopher may eat now.
+ */
+static bool	claim_forks(t_philo *p)
+{
+	t_fork	*low;
+	t_fork	*high;
+	bool	owned;
+
+	low = p->fork1;
+	high = p->fork2;
+	if (high < low)
+	{
+		low = p->fork2;
+		high = p->fork1;
+	}
+	stats_lock(p, &low->mutex);
+	stats_lock(p, &high->mutex);
+	owned = (low->owner == p->id - 1 && high->owner == p->id - 1);
+	if (owned == true)
+	{
+		low->busy = true;
+		high->busy = true;
+	}
+	pthread_mutex_unlock(&high->mutex);
+	pthread_mutex_unlock(&low->mutex);
+	return (owned);
+}
+
+/**
+ * Chandy/Misra dining philosophers: request both forks as messages to
+ * their holders and retry until both are held at once, or the run stops.
+ *
+ * @param p Philosopher taking the forks.
+ */
+void	chandy_take(t_philo *p)
+{
+	while (get_stop_simulation(p) == false)
+	{
+		request_fork(p, p->fork1);
+		request_fork(p, p->fork2);
+		if (claim_forks(p) == true)
+			break ;
+	}
+	philo_print(p, TOOK_FORK);
+	philo_print(p, TOOK_FORK);
+}
+
+/**
+ * After eating both forks are dirty, so pending requests are served.
+ *
+ * @param p Philosopher done eating.
+ */
+void	chandy_put(t_philo *p)
+{
+	stats_lock(p, &p->fork1->mutex);
+	p->fork1->busy = false;
+	p->fork1->dirty = true;
+	pthread_cond_broadcast(&p->fork1->cond);
+	pthread_mutex_unlock(&p->fork1->mutex);
+	stats_lock(p, &p->fork2->mutex);
+	p->fork2->busy = false;
+	p->fork2->dirty = true;
+	pthread_cond_broadcast(&p->fork2->cond);
+	pthread_mutex_unlock(&p->fork2->mutex);
+}
@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_ordered.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:51:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Resource-ordering rule: the last philosopher takes 'fork1' first,
+ * everyone else 'fork2' first, so no cycle of waiting philosophers can form.
+ *
+ * @param p Philosopher taking the forks.
+ * @param first Out parameter, fork to lock first.
+ * @param second Out parameter, fork to lock second.
+ */
+void	order_forks(t_philo *p, t_fork **first, t_fork **second)
+{
+	if (p->id == p->monitor->total_philos)
+	{
+		*first = p->fork1;
+		*second = p->fork2;
+	}
+	else
+	{
+		*first = p->fork2;
+		*second = p->fork1;
+	}
+}
+
+/**
+ * Acquire the fork mutexes of the philosopher's row of the topology, which
+ * lists them in resource order (on a ring, as order_forks() would), and
+ * print take-fork events.
+ *
+ * @param p Philosopher taking the forks.
+ */
+void	ordered_take(t_philo *p)
+{
+	int	i;
+
+	i = 0;
+	while (i < p->need_count)
+	{
+		stats_lock(p, &p->monitor->forks[p->needs[i++]].mutex);
+		philo_print(p, TOOK_FORK);
+	}
+}
+
+/**
+ * Release every fork mutex. Shared by 'ordered' and 'trylock'.
+ *
+ * @param p Philosopher done eating.
+ */
+void	ordered_put(t_philo *p)
+{
+	int	i;
+
+	i = p->need_count;
+	while (i > 0)
+		pthread_mutex_unlock(&p->monitor->forks[p->needs[--i]].mutex);
+}
+
+/**
+ * Lock the first fork, then only try the second one. If it is taken, drop
+ * the first fork again and back off for an exponentially growing, jittered
+ * delay before retrying, so a philosopher never sits on a fork its
+ * neighbour could be eating with. Both take-fork events are printed only
+ * once both forks are held.
+ *
+ * @param p Philosopher taking the forks.
+ */
+void	trylock_take(t_philo *p)
+{
+	t_fork	*first;
+	t_fork	*second;
+	int64_t	backoff;
+
+	order_forks(p, &first, &second);
+	backoff = BACKOFF_MIN;
+	while (true)
+	{
+		stats_lock(p, &first->mutex);
+		if (pthread_mutex_trylock(&second->mutex) == 0)
+			break ;
+		pthread_mutex_unlock(&first->mutex);
+		wait_for(p, backoff / 2 + current_time() % (backoff / 2 + 1));
+		if (backoff < BACKOFF_MAX)
+			backoff *= 2;
+	}
+	philo_print(p, TOOK_FORK);
+	philo_print(p, TOOK_FORK);
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_ticket.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:57:31 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:29:43 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Ticket lock on a fork: draw a ticket and sleep until it is being served,
+ * or the run stops, see stop_wake_forks(). Unlike a plain mutex, where
+ * whichever thread the scheduler wakes first wins, the fork is handed off
+ * in strict arrival order.
+ *
+ * @param p Philosopher taking the fork.
+ * @param f Fork to lock.
+ */
+static void	fork_lock(t_philo *p, t_fork *f)
+{
+	unsigned int	ticket;
+
+	stats_lock(p, &f->mutex);
+	ticket = f->next_ticket++;
+	while (f->now_serving != ticket && get_stop_simulation(p) == false)
+		pthread_cond_wait(&f->cond, &f->mutex);
+	pthread_mutex_unlock(&f->mutex);
+}
+
+/**
+ * Pass the fork to the next ticket holder.
+ *
+ * @param p Philosopher giving the fork back.
+ * @param f Fork to unlock.
+ */
+static void	fork_unlock(t_philo *p, t_fork *f)
+{
+	stats_lock(p, &f->mutex);
+	f->now_serving++;
+	pthread_cond_broadcast(&f->cond);
+	pthread_mutex_unlock(&f->mutex);
+}
+
+/**
+ * Same resource ordering as 'ordered', but on ticket-locked forks. Each
+ * fork is shared by two philosophers, so there is at most one waiter when
+ * it is released, and the releaser has just eaten: its deadline is the
+ * latest at the table. FIFO handoff therefore always serves the waiter
+ * closest to death, which can no longer lose the fork to a neighbour that
+ * got scheduled first.
+ *
+ * @param p Philosopher taking the forks.
+ */
+void	ticket_take(t_philo *p)
+{
+	t_fork	*first;
+	t_fork	*second;
+
+	order_forks(p, &first, &second);
+	fork_lock(p, first);
+	philo_print(p, TOOK_FORK);
+	fork_lock(p, second);
+	philo_print(p, TOOK_FORK);
+}
+
+/**
+ * Hand both forks to whoever is queued for them.
+ *
+ * @param p Philosopher done eating.
+ */
+void	ticket_put(t_philo *p)
+{
+	fork_unlock(p, p->fork1);
+	fork_unlock(p, p->fork2);
+}
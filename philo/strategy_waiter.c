@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_waiter.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:51:39 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:29:43 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return true if 'q' has been waiting for the waiter longer than 'p'.
+ */
+static bool	waiting_longer(t_philo *q, t_philo *p)
+{
+	return (q->ticket != 0 && q->ticket < p->ticket);
+}
+
+/**
+ * A philosopher may be seated when both its forks are free and neither
+ * neighbour it competes with holds an older ticket. Called with the
+ * waiter's mutex held.
+ */
+static bool	can_eat(t_philo *p)
+{
+	return (p->fork1->busy == false && p->fork2->busy == false
+		&& waiting_longer(philo_left(p), p) == false
+		&& waiting_longer(philo_right(p), p) == false);
+}
+
+/**
+ * Ask the waiter for both forks: take a ticket, then sleep on the
+ * philosopher's own condition variable until can_eat() holds, or the run
+ * stops (see waiter_wake()), which seats nobody. The ticket order makes
+ * the queue fair, while philosophers who do not compete for a fork still
+ * eat in parallel.
+ *
+ * @param p Philosopher taking the forks.
+ */
+void	waiter_take(t_philo *p)
+{
+	t_waiter *const	w = &p->monitor->waiter;
+
+	stats_lock(p, &w->mutex);
+	p->ticket = ++w->next_ticket;
+	while (can_eat(p) == false && get_stop_simulation(p) == false)
+		pthread_cond_wait(&p->turn, &w->mutex);
+	if (get_stop_simulation(p) == false)
+	{
+		p->fork1->busy = true;
+		p->fork2->busy = true;
+	}
+	p->ticket = 0;
+	pthread_mutex_unlock(&w->mutex);
+	philo_print(p, TOOK_FORK);
+	philo_print(p, TOOK_FORK);
+}
+
+/**
+ * Hand both forks back to the waiter and wake the two neighbours, the only
+ * philosophers whose can_eat() may have changed.
+ *
+ * @param p Philosopher done eating.
+ */
+void	waiter_put(t_philo *p)
+{
+	t_waiter *const	w = &p->monitor->waiter;
+
+	stats_lock(p, &w->mutex);
+	p->fork1->busy = false;
+	p->fork2->busy = false;
+	pthread_cond_signal(&philo_left(p)->turn);
+	pthread_cond_signal(&philo_right(p)->turn);
+	pthread_mutex_unlock(&w->mutex);
+}
+
+/**
+ * Stop wake of 'waiter': every philosopher waits on its own condition,
+ * broadcast under the waiter's mutex so none can miss the stop.
+ *
+ * @param m Monitor whose stop flag is raised.
+ */
+void	waiter_wake(t_monitor *m)
+{
+	int	i;
+
+	pthread_mutex_lock(&m->waiter.mutex);
+	i = 0;
+	while (i < m->total_philos)
+		pthread_cond_broadcast(&m->philos[i++].turn);
+	pthread_mutex_unlock(&m->waiter.mutex);
+}
@@ -288,7 +288,145 @@ run_death()
 	fi
 }
 
-trap "rm -rf .julesdeathlog .julesone .julesphilo1log .julesphilo2log .julesstderr .julestestfile .julestestout" EXIT
+# Function to test batch runs with a strategy. Feeds the same line several times and checks
+# that every run ends without a death. Concurrent runs reuse each other's heap memory.
+
+run_batch()
+{
+	local test_desc=$1
+	local strategy=$2
+	local line=$3
+	local runs=4
+	local runtime=20
+	local summaries
+	> .julesbatch
+	for i in $(seq $runs); do
+		echo "$line" >> .julesbatch
+	done
+	( ./philo -s $strategy -b .julesbatch 1> .julestestout 2> /dev/null ) &
+	PID=$!
+	SECONDS=0
+	while ps -p $PID > /dev/null; do
+		if [ $SECONDS -gt $runtime ]; then
+			kill $PID
+			echo -n "❌"
+			echo -e "$test_desc: Program timed out. Possible infinite loop\n" >> philo_trace
+			return 1
+		fi
+		sleep 1
+	done
+	summaries=$(grep -c "died=0" .julestestout)
+	if [ "$summaries" -ne $runs ]; then
+		echo -n "❌"
+		echo -e "$test_desc: $summaries of $runs runs ended without a death\n" >> philo_trace
+	else
+		echo -n "✅"
+	fi
+}
+
+# Function to test an option. Checks the last line of the log against an extended regex.
+
+run_last()
+{
+	local test_desc=$1
+	local expected=$2
+	local runtime=20
+	shift 2
+	> .julestestout
+	( ./philo "$@" 1> .julestestout 2> /dev/null ) &
+	PID=$!
+	SECONDS=0
+	while ps -p $PID > /dev/null; do
+		if [ $SECONDS -gt $runtime ]; then
+			kill $PID
+			echo -n "❌"
+			echo -e "$test_desc: Program timed out. Possible infinite loop\n" >> philo_trace
+			return 1
+		fi
+		sleep 1
+	done
+	if ! tail -n 1 .julestestout | grep -Eq "$expected"; then
+		echo -n "❌"
+		echo -e "$test_desc: Last line does not match $expected\n\tActual: $(tail -n 1 .julestestout)\n" >> philo_trace
+	else
+		echo -n "✅"
+	fi
+}
+
+# Function to test the des engine. Runs the same seed twice and checks the logs are identical,
+# then checks another seed breaks the ties differently.
+
+run_des()
+{
+	local test_desc=$1
+	local seed=$2
+	local other=$3
+	shift 3
+	timeout 20 ./philo -e des -d $seed "$@" > .julesdes1 2> /dev/null
+	timeout 20 ./philo -e des -d $seed "$@" > .julesdes2 2> /dev/null
+	timeout 20 ./philo -e des -d $other "$@" > .julesdes3 2> /dev/null
+	if [ ! -s .julesdes1 ] || ! diff -q .julesdes1 .julesdes2 > /dev/null; then
+		echo -n "❌"
+		echo -e "$test_desc: Two runs with seed $seed differ\n" >> philo_trace
+	elif diff -q .julesdes1 .julesdes3 > /dev/null; then
+		echo -n "❌"
+		echo -e "$test_desc: Seeds $seed and $other give the same log\n" >> philo_trace
+	else
+		echo -n "✅"
+	fi
+}
+
+# Function to test the trace. Records a run with -t and checks philo_analyze accepts it.
+
+run_analyze()
+{
+	local test_desc=$1
+	shift
+	if [ ! -x ./philo_analyze ]; then
+		echo -n "❌"
+		echo -e "$test_desc: philo_analyze not found, run make philo_analyze\n" >> philo_trace
+		return 1
+	fi
+	rm -f .julestrace
+	timeout 20 ./philo -t .julestrace "$@" > /dev/null 2>&1
+	if ! ./philo_analyze .julestrace > .julestestout 2>&1; then
+		echo -n "❌"
+		echo -e "$test_desc: philo_analyze rejected the trace\n\t$(head -n 1 .julestestout)\n" >> philo_trace
+	else
+		echo -n "✅"
+	fi
+}
+
+# Function to test the live stats. Runs with -L to the end and checks philo_top reads a stopped run
+# with the expected outcome.
+
+run_top()
+{
+	local test_desc=$1
+	local expected=$2
+	shift 2
+	if [ ! -x ./philo_top ]; then
+		echo -n "❌"
+		echo -e "$test_desc: philo_top not found, run make philo_top\n" >> philo_trace
+		return 1
+	fi
+	rm -f .juleslive
+	timeout 20 ./philo -L .juleslive "$@" > /dev/null 2>&1
+	if ! ./philo_top -n 1 .juleslive > .julestestout 2>&1; then
+		echo -n "❌"
+		echo -e "$test_desc: philo_top could not read the file\n\t$(head -n 1 .julestestout)\n" >> philo_trace
+	elif ! head -n 1 .julestestout | grep -q " stopped, "; then
+		echo -n "❌"
+		echo -e "$test_desc: Run not shown as stopped\n\t$(head -n 1 .julestestout)\n" >> philo_trace
+	elif ! grep -Eq "$expected" .julestestout; then
+		echo -n "❌"
+		echo -e "$test_desc: No line matches $expected\n" >> philo_trace
+	else
+		echo -n "✅"
+	fi
+}
+
+trap "rm -rf .julesbatch .julesdeathlog .julesdes1 .julesdes2 .julesdes3 .julesone .julesphilo1log .julesphilo2log .julesstderr .julestestfile .julestestout .julestrace .julesprofile .juleslive" EXIT
 
 echo -e "
 ${PURPLE}#################################################################################################################${RESET}
@@ -409,6 +547,84 @@ run_death "10 199 100 100 10" 10 199 100 100 10
 echo -e "\n"
 rm -rf .julestestout .julesphilo1log .julesphilo2log .julesdeathlog
 
+# Run tests on other topologies. A philosopher with under two forks can never eat.
+
+echo -e "${PURPLE}--- ${WHITE}Topology Tests${PURPLE} ---\n${RESET}"
+echo -e "-- Topology Tests --\n" >> philo_trace
+
+run_last "-g grid 1 800 200 200 3" "^80[0-9] 1 died$" -g grid 1 800 200 200 3
+run_last "-g complete 1 800 200 200 3" "^80[0-9] 1 died$" -g complete 1 800 200 200 3
+run_last "-e pool -g grid 1 800 200 200 3" "^80[0-9] 1 died$" -e pool -g grid 1 800 200 200 3
+run_last "-g grid 4 800 200 200 3" "eating|sleeping|thinking" -g grid 4 800 200 200 3
+echo -e "\n"
+rm -rf .julestestout
+
+# Run the des engine with fixed seeds. Its log only depends on the arguments and the seed.
+
+echo -e "${PURPLE}--- ${WHITE}Determinism Tests${PURPLE} ---\n${RESET}"
+echo -e "-- Determinism Tests --\n" >> philo_trace
+
+run_des "-e des -d 1 5 800 200 200 3" 1 2 5 800 200 200 3
+run_des "-e des -d 42 7 600 200 200 5" 42 7 7 600 200 200 5
+run_des "-e des -d 42 4 310 200 100" 42 7 4 310 200 100
+echo -e "\n"
+rm -rf .julesdes1 .julesdes2 .julesdes3
+
+# Record traces with -t and check them with philo_analyze, with and without a death.
+
+echo -e "${PURPLE}--- ${WHITE}Trace Tests${PURPLE} ---\n${RESET}"
+echo -e "-- Trace Tests --\n" >> philo_trace
+
+run_analyze "-t 5 800 200 200 3" 5 800 200 200 3
+run_analyze "-t 4 310 200 100" 4 310 200 100
+run_analyze "-t -s waiter 4 410 200 200 5" -s waiter 4 410 200 200 5
+echo -e "\n"
+rm -rf .julestestout .julestrace
+
+# Run with -P profiles. Philosopher 3 cannot last a meal and a sleep, the others can.
+
+echo -e "${PURPLE}--- ${WHITE}Profile Tests${PURPLE} ---\n${RESET}"
+echo -e "-- Profile Tests --\n" >> philo_trace
+
+printf '# eat and sleep are drawn\n*\teat=uniform:150:250 sleep=exp:100\nodd sleep=200\n3 die=300 eat=200\n2-4 must_eat=3\n' > .julesprofile
+run_last "-P (3 die=300) 5 800 200 200" "^40[0-9] 3 died$" -P .julesprofile 5 800 200 200
+printf 'even eat=exp:100 sleep=uniform:100:200\n1-9 must_eat=2\n' > .julesprofile
+run_last "-P (even exp, 1-9 must_eat=2) 5 800 200 200 3" "eating|sleeping|thinking" -P .julesprofile 5 800 200 200 3
+run_err "-P missing file" -P .julesnoprofile 5 800 200 200
+printf '* eat=uniform:300:100\n' > .julesprofile
+run_err "-P (eat=uniform:300:100)" -P .julesprofile 5 800 200 200
+printf '0 eat=100\n' > .julesprofile
+run_err "-P (0 eat=100)" -P .julesprofile 5 800 200 200
+printf '* die=exp:100\n' > .julesprofile
+run_err "-P (die=exp:100)" -P .julesprofile 5 800 200 200
+printf 'odd\n' > .julesprofile
+run_err "-P (odd)" -P .julesprofile 5 800 200 200
+echo -e "\n"
+rm -rf .julestestfile .julestestout .julesstderr .julesprofile
+
+# Run with -L and read the finished run back with philo_top.
+
+echo -e "${PURPLE}--- ${WHITE}Live Stats Tests${PURPLE} ---\n${RESET}"
+echo -e "-- Live Stats Tests --\n" >> philo_trace
+
+run_top "-L 4 310 200 100" "^closest to death: philo [0-9]+ died$" 4 310 200 100
+run_top "-L 5 800 200 200 3" "every philo is full$" 5 800 200 200 3
+printf '3 die=300\n' > .julesprofile
+run_top "-L -P (3 die=300) 5 800 200 200" "^closest to death: philo 3 died$" -P .julesprofile 5 800 200 200
+echo -e "\n"
+rm -rf .julestestout .juleslive .julesprofile
+
+# Run batches of concurrent runs for the strategies with their own fork state.
+
+echo -e "${PURPLE}--- ${WHITE}Batch Tests${PURPLE} ---\n${RESET}"
+echo -e "-- Batch Tests --\n" >> philo_trace
+
+run_batch "-s ticket 5 800 200 200 3" ticket "5 800 200 200 3"
+run_batch "-s waiter 5 800 200 200 3" waiter "5 800 200 200 3"
+run_batch "-s chandy 5 800 200 200 3" chandy "5 800 200 200 3"
+echo -e "\n"
+rm -rf .julestestout .julesbatch .julesbatch.*.log
+
 echo -e "---- TRACE ENDS ----" >> philo_trace
 echo -e "${PURPLE}--- ${WHITE}Testing complete: philo_trace created${PURPLE} ---\n${RESET}"
 
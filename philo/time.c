@@ -6,79 +6,73 @@
 /*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/11/28 00:36:27 by tpirinen          #+#    #+#             */
-/*   Updated: 2026/01/05 15:35:15 by tpirinen         ###   ########.fr       */
+/*   Updated: 2026/10/17 06:31:51 by tpirinen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /**
- * @return Current time in microseconds (int64_t).
+ * '-w': block on the philosopher's semaphore until the timer service posts
+ * it at 'target_time', or until threads_stop() posts it. A timer fired early
+ * (see wheel_insert()) is simply armed again.
+ *
+ * @param p Philosopher using the wait.
+ * @param target_time Absolute time in microseconds to wait until.
  */
-int64_t	current_time(void)
+static void	wait_on_timer(t_philo *p, int64_t target_time)
 {
-	struct timeval	timeval;
-
-	gettimeofday(&timeval, NULL);
-	return (timeval.tv_sec * 1000000 + timeval.tv_usec);
+	while (current_time() < target_time && get_stop_simulation(p) == false)
+	{
+		if (timers_arm(&p->monitor->timers, p->id - 1, target_time) == -1)
+			return ;
+		while (sem_wait(&p->wakeup) == -1 && errno == EINTR)
+			;
+	}
 }
 
 /**
- * Busy-waits (with short sleeps) until the monitor has set the
- * philosopher's 'start_time'. This ensures all threads begin at a common
- * start time.
+ * Sleep on an absolute deadline until 'target_time', see stop_sleep_until(),
+ * which returns as soon as the run is stopped. The last 'SPIN_THRESHOLD' is
+ * spent yielding instead of sleeping, since the kernel tends to oversleep
+ * by tens of microseconds.
  *
- * @param p Philosopher whose start_time to wait for.
+ * @param p Philosopher using the wait.
+ * @param target_time Absolute time in microseconds to wait until.
  */
-void	wait_for_start_time(t_philo *p)
+static void	wait_sliced(t_philo *p, int64_t target_time)
 {
-	while (!get_stop_simulation(p) && !get_start_time(p))
-		wait_for(p, WAIT_SEGMENT);
-	wait_until(p, get_start_time(p));
-}
+	int64_t	now;
+	int64_t	wake_time;
 
-/**
- * Delays the starting time for every odd philosopher
- */
-void	stagger_starting_times(t_philo *p)
-{
-	if (p->id % 2 != 0)
+	now = current_time();
+	while (now < target_time && get_stop_simulation(p) == false)
 	{
-		if (p->monitor->total_philos > 100)
-		{
-			while (get_stop_simulation(p) == false
-				&& (current_time() - get_start_time(p)) < p->time_to_eat)
-				usleep(500);
-		}
+		wake_time = target_time - SPIN_THRESHOLD;
+		if (wake_time > now)
+			stop_sleep_until(p->monitor, wake_time);
 		else
-		{
-			while (get_stop_simulation(p) == false
-				&& (current_time() - get_start_time(p)) < (p->time_to_eat / 2))
-				usleep(500);
-		}
+			sched_yield();
+		now = current_time();
 	}
 }
 
 /**
- * Sleep in short segments until 'target_time', checking 'p->stop_simulation'
- * between segments so the thread doesn't wait unnecessarily
- * when the simulation ends.
+ * Wait until 'target_time' with wait_sliced(), or with '-w' on the timer
+ * service, see wait_on_timer(). Unless the run was stopped, how late the
+ * wait returned goes into the oversleep histogram.
  *
  * @param p Philosopher using the wait.
  * @param target_time Absolute time in microseconds to wait until.
  */
 void	wait_until(t_philo *p, int64_t target_time)
 {
-	int64_t	difference;
-
-	difference = target_time - current_time();
-	while (get_stop_simulation(p) == false && difference > 0)
-	{
-		if (difference > WAIT_SEGMENT)
-			difference = WAIT_SEGMENT;
-		usleep(difference);
-		difference = target_time - current_time();
-	}
+	if (p->monitor->opts.wheel)
+		wait_on_timer(p, target_time);
+	else
+		wait_sliced(p, target_time);
+	if (p->monitor->stats != NULL && get_stop_simulation(p) == false)
+		stats_record(p, STAT_OVERSLEEP, current_time() - target_time);
 }
 
 /**
@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timers.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:41:14 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:41:14 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Sleep until the next tick worth waking up for (see wheel_next()), or
+ * until timers_arm() or timers_stop() signals. As in wait_until(), the last
+ * 'SPIN_THRESHOLD' is spent yielding instead of paying the kernel's wakeup
+ * latency. Called and returns with 't->mutex' held.
+ */
+static void	timers_sleep(t_timers *t)
+{
+	struct timespec	ts;
+	int64_t			due;
+
+	t->due = wheel_next(&t->wheel);
+	due = t->due * WHEEL_TICK - SPIN_THRESHOLD;
+	ts.tv_sec = due / 1000000;
+	ts.tv_nsec = (due % 1000000) * 1000;
+	if (due > current_time())
+		pthread_cond_timedwait(&t->cond, &t->mutex, &ts);
+	else
+	{
+		pthread_mutex_unlock(&t->mutex);
+		sched_yield();
+		pthread_mutex_lock(&t->mutex);
+	}
+}
+
+/**
+ * Timer thread: fire the timers that came due, then sleep until the next
+ * one, until the service is closed. Timers fire at most one 'WHEEL_TICK'
+ * late, and an idle wheel costs one wakeup per span of its lowest level.
+ *
+ * @param arg Pointer to the 't_timers'.
+ * @return NULL.
+ */
+static void	*timers_main(void *arg)
+{
+	t_timers *const	t = arg;
+
+	pthread_mutex_lock(&t->mutex);
+	while (t->closed == false)
+	{
+		wheel_advance(&t->wheel, current_time() / WHEEL_TICK, t->fire,
+			t->monitor);
+		timers_sleep(t);
+	}
+	pthread_mutex_unlock(&t->mutex);
+	return (NULL);
+}
+
+/**
+ * Start a timer service with one timer per philosopher. 'fire' is called
+ * from the timer thread, with the service locked, for each expired timer.
+ *
+ * @param t Service to start, zeroed by the caller.
+ * @param m Monitor passed to 'fire'.
+ * @param fire Callback taking the index of the philosopher.
+ * @return 0 on success, -1 on allocation or pthread_create failure.
+ */
+int	timers_start(t_timers *t, t_monitor *m, void (*fire)(t_monitor *, int))
+{
+	pthread_condattr_t	attr;
+
+	t->monitor = m;
+	t->fire = fire;
+	pthread_mutex_init(&t->mutex, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&t->cond, &attr);
+	pthread_condattr_destroy(&attr);
+	t->initialized = true;
+	if (wheel_init(&t->wheel, m->total_philos,
+			current_time() / WHEEL_TICK) == -1)
+		return (-1);
+	if (pthread_create(&t->thread, NULL, timers_main, t) != 0)
+		return (-1);
+	t->started = true;
+	return (0);
+}
+
+/**
+ * Arm the timer of philosopher 'id' to fire at 'when', waking the timer
+ * thread if it is due before its next wakeup.
+ *
+ * @param t Timer service.
+ * @param id Philosopher index, whose timer must not be pending.
+ * @param when Absolute time in microseconds.
+ * @return 0 on success, -1 if the service is closed and nothing was armed.
+ */
+int	timers_arm(t_timers *t, int id, int64_t when)
+{
+	pthread_mutex_lock(&t->mutex);
+	if (t->closed == true)
+	{
+		pthread_mutex_unlock(&t->mutex);
+		return (-1);
+	}
+	wheel_insert(&t->wheel, id, when);
+	if (t->wheel.timers[id].tick < t->due)
+		pthread_cond_signal(&t->cond);
+	pthread_mutex_unlock(&t->mutex);
+	return (0);
+}
+
+/**
+ * Close the service so timers_arm() fails from now on, join the timer
+ * thread and free the wheel. Timers still pending never fire; the caller
+ * wakes their owners. Does nothing if timers_start() was never called.
+ *
+ * @param t Timer service.
+ */
+void	timers_stop(t_timers *t)
+{
+	if (t->initialized == false)
+		return ;
+	pthread_mutex_lock(&t->mutex);
+	t->closed = true;
+	pthread_cond_signal(&t->cond);
+	pthread_mutex_unlock(&t->mutex);
+	if (t->started)
+		pthread_join(t->thread, NULL);
+	free(t->wheel.timers);
+	pthread_cond_destroy(&t->cond);
+	pthread_mutex_destroy(&t->mutex);
+	t->initialized = false;
+}
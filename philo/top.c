@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:54:52 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:54:52 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "top.h"
+
+/**
+ * Parse the flags given before the file: '-n <count>' to stop after that
+ * many refreshes, '-d <ms>' for the time between them.
+ *
+ * @return Index of the file argument, -1 on bad usage.
+ */
+static int	parse_flags(t_top *t, int ac, char **av)
+{
+	int	value;
+	int	i;
+
+	t->interval = TOP_INTERVAL;
+	t->count = -1;
+	i = 1;
+	while (i + 2 < ac && (strcmp(av[i], "-n") == 0
+			|| strcmp(av[i], "-d") == 0))
+	{
+		value = parse_nbr(av[i + 1]);
+		if (av[i + 1][0] == '\0' || value <= 0
+			|| (av[i][1] == 'd' && value > TOP_INTERVAL_MAX))
+			return (-1);
+		if (av[i][1] == 'n')
+			t->count = value;
+		else
+			t->interval = value;
+		i += 2;
+	}
+	if (i != ac - 1)
+		return (-1);
+	return (i);
+}
+
+/**
+ * Map 'path' read-only and shared, so every update of the run shows, and
+ * check that it holds the live stats of a run: the right magic and
+ * version, and a slot per philosopher. A file whose run has not published
+ * its first update yet has no magic.
+ *
+ * @return 0 on success, -1 with an error printed otherwise.
+ */
+static int	map_live(t_top *t, const char *path)
+{
+	struct stat	st;
+	void		*map;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	map = MAP_FAILED;
+	if (fd != -1 && fstat(fd, &st) == 0
+		&& st.st_size >= (off_t) sizeof(t_live_header))
+	{
+		t->size = st.st_size;
+		map = mmap(NULL, t->size, PROT_READ, MAP_SHARED, fd, 0);
+	}
+	if (fd != -1)
+		close(fd);
+	t->head = map;
+	if (map == MAP_FAILED || t->head->magic != LIVE_MAGIC
+		|| t->head->version != LIVE_VERSION || t->head->philos < 1
+		|| t->size != sizeof(t_live_header)
+		+ (size_t)t->head->philos * sizeof(t_live_philo))
+	{
+		printf("error: %s is not a philo live stats file\n", path);
+		return (-1);
+	}
+	t->slots = (const t_live_philo *)(t->head + 1);
+	return (0);
+}
+
+/**
+ * Read and print the file every 'interval' until the run stops, its
+ * process is gone or the '-n' count is used up. The status is read before
+ * the rows, so the last refresh of a stopped run shows its final figures.
+ *
+ * @return 0 once done, 1 if the run is gone without stopping.
+ */
+static int	top_loop(t_top *t)
+{
+	int	status;
+	int	gone;
+
+	status = LIVE_RUNNING;
+	gone = 0;
+	while (t->count != 0)
+	{
+		status = atomic_load_explicit(&t->head->status, memory_order_acquire);
+		top_read(t);
+		top_render(t);
+		gone = (kill(t->head->pid, 0) == -1 && errno == ESRCH);
+		if (status != LIVE_RUNNING || gone)
+			break ;
+		if (t->count > 0)
+			t->count--;
+		if (t->count != 0)
+			usleep(t->interval * 1000);
+	}
+	if (gone && status == LIVE_RUNNING)
+		printf("philo_top: pid %d is gone, the run did not stop\n",
+			t->head->pid);
+	return (gone && status == LIVE_RUNNING);
+}
+
+/**
+ * philo_top [-n count] [-d ms] <file>: watch a run started with
+ * 'philo -L <file>' as top would, without attaching to it: the table is
+ * read from the shared mapping the run updates, see live_publish().
+ *
+ * @return 0 once the run stopped or '-n' refreshes are done, 1 if the run
+ * disappeared, 2 on bad usage or an unreadable file.
+ */
+int	main(int ac, char **av)
+{
+	t_top	t;
+	int		file;
+	int		status;
+
+	memset(&t, 0, sizeof(t));
+	file = parse_flags(&t, ac, av);
+	if (file == -1)
+	{
+		printf("usage: philo_top [-n count] [-d ms] <file>\n");
+		return (2);
+	}
+	if (map_live(&t, av[file]) == -1)
+		return (2);
+	t.rows = calloc(t.head->philos, sizeof(t_top_row));
+	t.order = malloc(t.head->philos * sizeof(int));
+	status = 2;
+	if (t.rows != NULL && t.order != NULL)
+		status = top_loop(&t);
+	free(t.rows);
+	free(t.order);
+	munmap((void *)t.head, t.size);
+	return (status);
+}
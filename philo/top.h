@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top.h                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:53:48 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:56:53 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TOP_H
+# define TOP_H
+
+# include "philo.h"
+# include <sys/stat.h>	//	- fstat()
+# include <sys/ioctl.h>	//	- TIOCGWINSZ
+# include <signal.h>	//	- kill()
+
+# define TOP_INTERVAL 1000				// (milliseconds) between refreshes
+# define TOP_INTERVAL_MAX 60000			// (milliseconds) of '-d', at most
+# define TOP_HEAD_LINES 6				// printed above the table
+# define TOP_ROWS 20						// of the table, not on a terminal
+
+typedef struct s_top_row	t_top_row;
+typedef struct s_top		t_top;
+
+/**
+ * One philosopher as philo_top last read it, with its rates since the read
+ * before.
+ */
+struct s_top_row
+{
+	int					meals;
+	int					doing;				// enum e_state, -1 before any
+	int64_t				events;
+	int64_t				hunger;				// (microseconds) since it ate
+	int64_t				left;				// to live, INT64_MAX full, MIN dead
+	int64_t				worst;				// least time left at a meal
+	double				meal_rate;			// per second
+	double				event_rate;			// per second
+};
+
+/**
+ * A mapped '-L' file and what philo_top remembers between two refreshes.
+ */
+struct s_top
+{
+	const t_live_header	*head;
+	const t_live_philo	*slots;				// after the head
+	size_t				size;				// of the mapping
+	t_top_row			*rows;				// indexed by id - 1
+	int					*order;				// rows by time left, see top_read()
+	int64_t				elapsed;			// of the run, at the last read
+	int64_t				meals;				// of every philo, at the last read
+	int64_t				events;				// of every philo, at the last read
+	double				meal_rate;			// per second, the whole table
+	double				event_rate;			// per second, the whole table
+	int					worst;				// index of the least worst margin
+	int					interval;			// (milliseconds) between refreshes
+	int					count;				// refreshes left, -1 for no limit
+};
+
+// top_read.c
+void	top_read(t_top *t);
+
+// top_render.c
+void	top_render(const t_top *t);
+
+#endif
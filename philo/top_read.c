@@ -0,0 +1,119 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top_read.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:54:52 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:56:53 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "top.h"
+
+/**
+ * qsort_r() order of the table: the dead, then the philosopher closest to
+ * death, the full ones last, ties by id.
+ *
+ * @param ctx The rows the indices point into.
+ */
+static int	by_time_left(const void *a, const void *b, void *ctx)
+{
+	const t_top_row *const	rows = ctx;
+	const int				i = *(const int *)a;
+	const int				j = *(const int *)b;
+
+	if (rows[i].left < rows[j].left)
+		return (-1);
+	if (rows[i].left > rows[j].left)
+		return (1);
+	return (i - j);
+}
+
+/**
+ * Read one philosopher's slot into its row, with its rates over the 'dt'
+ * seconds since the previous read.
+ */
+static void	read_row(t_top_row *r, const t_live_philo *s, double dt)
+{
+	const int		meals = atomic_load_explicit(&s->meals,
+			memory_order_relaxed);
+	const int64_t	events = atomic_load_explicit(&s->events,
+			memory_order_relaxed);
+
+	r->meal_rate = 0;
+	r->event_rate = 0;
+	if (dt > 0)
+	{
+		r->meal_rate = (meals - r->meals) / dt;
+		r->event_rate = (events - r->events) / dt;
+	}
+	r->meals = meals;
+	r->events = events;
+	r->doing = atomic_load_explicit(&s->doing, memory_order_relaxed);
+	r->hunger = atomic_load_explicit(&s->hunger, memory_order_relaxed);
+	r->worst = atomic_load_explicit(&s->worst_margin, memory_order_relaxed);
+	r->left = s->time_to_die - r->hunger;
+	if (meals >= s->must_eat)
+		r->left = INT64_MAX;
+	if (r->doing == DEAD)
+		r->left = INT64_MIN;
+}
+
+/**
+ * Totals of the table, and their rates over the 'dt' seconds since the
+ * previous read.
+ *
+ * @param meals Meals of every philosopher, just read.
+ */
+static void	read_totals(t_top *t, int64_t meals, double dt)
+{
+	const int64_t	events = atomic_load_explicit(&t->head->events,
+			memory_order_relaxed);
+
+	t->meal_rate = 0;
+	t->event_rate = 0;
+	if (dt > 0)
+	{
+		t->meal_rate = (meals - t->meals) / dt;
+		t->event_rate = (events - t->events) / dt;
+	}
+	t->meals = meals;
+	t->events = events;
+}
+
+/**
+ * Read the latest update of the live stats file: every philosopher's row,
+ * the totals and their rates since the previous read, see read_totals(),
+ * and sort the table by time left, see by_time_left().
+ *
+ * @param t Viewer with the file mapped, see main().
+ */
+void	top_read(t_top *t)
+{
+	const int	philos = t->head->philos;
+	int64_t		elapsed;
+	int64_t		meals;
+	double		dt;
+	int			i;
+
+	atomic_load_explicit(&t->head->updates, memory_order_acquire);
+	elapsed = atomic_load_explicit(&t->head->elapsed, memory_order_relaxed);
+	dt = (elapsed - t->elapsed) / 1e6;
+	meals = 0;
+	t->worst = 0;
+	i = 0;
+	while (i < philos)
+	{
+		read_row(&t->rows[i], &t->slots[i], dt);
+		meals += t->rows[i].meals;
+		if (t->rows[i].worst < t->rows[t->worst].worst)
+			t->worst = i;
+		t->order[i] = i;
+		i++;
+	}
+	read_totals(t, meals, dt);
+	t->elapsed = elapsed;
+	qsort_r(t->order, philos, sizeof(int), by_time_left, t->rows);
+}
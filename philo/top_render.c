@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top_render.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:54:52 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:56:53 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "top.h"
+
+/**
+ * @return What a philosopher was last seen doing, "full" once it stopped
+ * eating, "-" before any event.
+ */
+static const char	*doing_name(const t_top_row *r)
+{
+	static const char *const	names[] = {"fork", "eating", "sleeping",
+		"thinking", "dead"};
+
+	if (r->left == INT64_MAX)
+		return ("full");
+	if (r->doing < TOOK_FORK || r->doing > DEAD)
+		return ("-");
+	return (names[r->doing]);
+}
+
+/**
+ * Who is closest to death now, or died, and whose meal came closest to it
+ * so far.
+ */
+static void	render_margins(const t_top *t)
+{
+	const t_top_row *const	first = &t->rows[t->order[0]];
+	const t_top_row *const	worst = &t->rows[t->worst];
+
+	if (first->left == INT64_MIN)
+		printf("closest to death: philo %d died\n", t->order[0] + 1);
+	else if (first->left == INT64_MAX)
+		printf("closest to death: nobody, every philo is full\n");
+	else
+		printf("closest to death: philo %d, %.1f ms left\n",
+			t->order[0] + 1, first->left / 1e3);
+	if (worst->worst == INT64_MAX)
+		printf("worst margin so far: no meal yet\n");
+	else
+		printf("worst margin so far: philo %d, %.1f ms\n", t->worst + 1,
+			worst->worst / 1e3);
+}
+
+/**
+ * The lines above the table: the run, the totals and their rates, then
+ * render_margins().
+ */
+static void	render_head(const t_top *t)
+{
+	const t_live_header *const	h = t->head;
+	const char					*status;
+
+	status = "running";
+	if (atomic_load_explicit(&h->status, memory_order_relaxed) != LIVE_RUNNING)
+		status = "stopped";
+	printf("philo_top - pid %d %s, %.3f s, %d philos, %d full\n", h->pid,
+		status, t->elapsed / 1e6, h->philos,
+		atomic_load_explicit(&h->full, memory_order_relaxed));
+	printf("meals %ld (%.1f/s), events %ld (%.1f/s)\n", (long)t->meals,
+		t->meal_rate, (long)t->events, t->event_rate);
+	render_margins(t);
+	printf("\n%6s %-9s %8s %8s %9s %10s %9s %9s\n", "ID", "STATE", "MEALS",
+		"MEALS/S", "EVENTS/S", "HUNGER_MS", "LEFT_MS", "WORST_MS");
+}
+
+/**
+ * One line of the table, for philosopher 'idx'.
+ */
+static void	render_row(const t_top *t, int idx)
+{
+	const t_top_row *const	r = &t->rows[idx];
+	char					left[24];
+	char					worst[24];
+
+	snprintf(left, sizeof(left), "-");
+	if (r->left != INT64_MAX && r->left != INT64_MIN)
+		snprintf(left, sizeof(left), "%.1f", r->left / 1e3);
+	snprintf(worst, sizeof(worst), "-");
+	if (r->worst != INT64_MAX)
+		snprintf(worst, sizeof(worst), "%.1f", r->worst / 1e3);
+	printf("%6d %-9s %8d %8.1f %9.1f %10.1f %9s %9s\n", idx + 1,
+		doing_name(r), r->meals, r->meal_rate, r->event_rate,
+		r->hunger / 1e3, left, worst);
+}
+
+/**
+ * Print the last read of the file, see top_read(): on a terminal, like
+ * top, over the previous one and with as many philosophers as fit, closest
+ * to death first; otherwise as a plain report of the first 'TOP_ROWS'.
+ *
+ * @param t Viewer after top_read().
+ */
+void	top_render(const t_top *t)
+{
+	struct winsize	ws;
+	int				rows;
+	int				i;
+
+	rows = TOP_ROWS;
+	if (isatty(STDOUT_FILENO))
+	{
+		printf("\033[H\033[2J");
+		if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0
+			&& ws.ws_row > TOP_HEAD_LINES)
+			rows = ws.ws_row - TOP_HEAD_LINES - 1;
+	}
+	render_head(t);
+	i = 0;
+	while (i < rows && i < t->head->philos)
+		render_row(t, t->order[i++]);
+	fflush(stdout);
+}
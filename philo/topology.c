@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:26:55 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 08:49:26 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Record that 'philo' needs 'resource' for its meals. The table has as
+ * many forks as the highest resource named, plus one.
+ *
+ * @param t Topology being built, see topology_build().
+ * @return 0 on success, -1 on allocation failure.
+ */
+int	topology_add(t_topology *t, int philo, int resource)
+{
+	int	*pairs;
+
+	if (t->pair_count == t->pair_cap)
+	{
+		t->pair_cap = t->pair_cap * 2 + 64;
+		pairs = realloc(t->pairs, 2 * (size_t)t->pair_cap * sizeof(int));
+		if (pairs == NULL)
+			return (-1);
+		t->pairs = pairs;
+	}
+	t->pairs[2 * t->pair_count] = philo;
+	t->pairs[2 * t->pair_count + 1] = resource;
+	t->pair_count++;
+	if (resource >= t->resources)
+		t->resources = resource + 1;
+	return (0);
+}
+
+/**
+ * The strategies other than 'ordered' and the think policies other than
+ * 'fixed' work out who sits next to whom on a ring. On any other topology
+ * they are replaced, and the replacement is reported on stderr unless the
+ * policy is only the default one. 'fixed' staggers by the philosopher's
+ * own meal there, see stagger_delay().
+ */
+static void	topology_fallback(t_monitor *m)
+{
+	if (m->topology.ring)
+		return ;
+	if (m->opts.strategy != strategy_find("ordered"))
+	{
+		fprintf(stderr, "topology: '-s %s' needs a ring, using '-s ordered'\n",
+			m->opts.strategy->name);
+		m->opts.strategy = strategy_find("ordered");
+	}
+	if (m->opts.policy != policy_find("fixed"))
+	{
+		if (m->opts.policy_given)
+			fprintf(stderr, "topology: '-p %s' plans for a ring, using "
+				"'-p fixed'\n", m->opts.policy->name);
+		m->opts.policy = policy_find("fixed");
+	}
+}
+
+/**
+ * '-g': list the resources of every meal with the selected generator, or
+ * from a file when the value names none, and lay them out in rows, see
+ * topology_rows(). Without '-g' the table is a ring.
+ *
+ * @param m Monitor with 'total_philos' and the options set.
+ * @return 0 on success, -1 on an invalid topology or allocation failure.
+ */
+int	topology_build(t_monitor *m)
+{
+	const char *const	name = m->opts.topology;
+	int					status;
+
+	if (name == NULL || strcmp(name, "ring") == 0)
+		status = topology_ring(m);
+	else if (strcmp(name, "grid") == 0)
+		status = topology_grid(m);
+	else if (strcmp(name, "complete") == 0)
+		status = topology_complete(m);
+	else if (strncmp(name, "regular:", 8) == 0)
+		status = topology_regular(m, parse_nbr(name + 8));
+	else
+		status = topology_file(m, name);
+	if (status == 0)
+		status = topology_rows(m);
+	free(m->topology.pairs);
+	m->topology.pairs = NULL;
+	if (status == 0)
+		topology_fallback(m);
+	return (status);
+}
+
+/**
+ * Release the rows of a topology.
+ */
+void	topology_free(t_topology *t)
+{
+	free(t->offsets);
+	free(t->needs);
+	free(t->pairs);
+	t->offsets = NULL;
+	t->needs = NULL;
+	t->pairs = NULL;
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_file.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:27:36 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:27:36 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Read the resources listed on one line of a topology file, as decimal
+ * numbers separated by blanks. A '#' starts a comment that runs to the end
+ * of the line.
+ *
+ * @param philo Index of the philosopher the line is for.
+ * @return 1 for a philosopher, 0 for a line without resources, -1 if the
+ * line is invalid or on allocation failure.
+ */
+static int	file_row(t_topology *t, const char *line, int philo)
+{
+	int	listed;
+	int	value;
+
+	listed = 0;
+	while (*line != '\0' && *line != '#' && *line != '\n')
+	{
+		if (*line == ' ' || *line == '\t')
+			line++;
+		else if (*line < '0' || *line > '9')
+			return (-1);
+		else
+		{
+			value = 0;
+			while (*line >= '0' && *line <= '9' && value < RESOURCE_MAX)
+				value = value * 10 + (*line++ - '0');
+			if (value >= RESOURCE_MAX || topology_add(t, philo, value) == -1)
+				return (-1);
+			listed = 1;
+		}
+	}
+	return (listed);
+}
+
+/**
+ * Read every line of 'file' with file_row().
+ *
+ * @return Number of philosophers listed, or -1 - the index of the one whose
+ * line is invalid.
+ */
+static int	file_rows(t_topology *t, FILE *file)
+{
+	char	*line;
+	size_t	size;
+	int		philo;
+	int		status;
+
+	line = NULL;
+	size = 0;
+	philo = 0;
+	status = 0;
+	while (status != -1 && getline(&line, &size, file) != -1)
+	{
+		status = file_row(t, line, philo);
+		philo += (status == 1);
+	}
+	free(line);
+	if (status == -1)
+		return (-1 - philo);
+	return (philo);
+}
+
+/**
+ * '-g <file>': one line per philosopher, in order, listing the resources
+ * it needs for a meal; blank lines and comments are skipped. Any two
+ * philosophers listing the same resource compete for that fork, so this
+ * describes any graph of locks and holders, not only the generators'.
+ *
+ * @param path File to read.
+ * @return 0 on success, -1 with an error printed otherwise.
+ */
+int	topology_file(t_monitor *m, const char *path)
+{
+	FILE	*file;
+	int		philos;
+
+	file = fopen(path, "r");
+	if (file == NULL)
+	{
+		perror(path);
+		return (-1);
+	}
+	philos = file_rows(&m->topology, file);
+	fclose(file);
+	if (philos < 0)
+		printf("error: %s: invalid resources for philosopher %d\n", path,
+			-philos);
+	else if (philos != m->total_philos)
+		printf("error: %s lists %d philosophers, not %d\n", path, philos,
+			m->total_philos);
+	else
+		return (0);
+	return (-1);
+}
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_gen.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:27:35 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:27:35 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Add a fork shared by philosophers 'a' and 'b', after the others.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	add_edge(t_topology *t, int a, int b)
+{
+	const int	resource = t->resources;
+
+	if (topology_add(t, a, resource) == -1
+		|| topology_add(t, b, resource) == -1)
+		return (-1);
+	return (0);
+}
+
+/**
+ * 'ring', the default: fork 'r' lies between philosophers 'r' - 1 and 'r',
+ * so philosopher 'i' eats with forks 'i' and 'i' + 1, as fork1 and fork2
+ * of philo_init(). A lone philosopher has one fork.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+int	topology_ring(t_monitor *m)
+{
+	const int	n = m->total_philos;
+	int			r;
+
+	m->topology.ring = true;
+	r = 0;
+	while (r < n)
+	{
+		if (topology_add(&m->topology, r, r) == -1 || (n > 1
+				&& topology_add(&m->topology, (r + n - 1) % n, r) == -1))
+			return (-1);
+		r++;
+	}
+	return (0);
+}
+
+/**
+ * 'grid': the philosophers sit row by row on the smallest square grid
+ * that holds them, with a fork between every two that are next to each
+ * other in a row or a column. A meal takes two to four forks.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+int	topology_grid(t_monitor *m)
+{
+	const int	n = m->total_philos;
+	int			cols;
+	int			i;
+
+	cols = 1;
+	while (cols * cols < n)
+		cols++;
+	i = 0;
+	while (i < n)
+	{
+		if ((i + 1) % cols != 0 && i + 1 < n
+			&& add_edge(&m->topology, i, i + 1) == -1)
+			return (-1);
+		if (i + cols < n && add_edge(&m->topology, i, i + cols) == -1)
+			return (-1);
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * 'complete': a fork between every two philosophers, so a meal takes every
+ * fork of the eater and only one philosopher eats at a time. The forks grow
+ * as the square of the table, which 'COMPLETE_MAX' bounds.
+ *
+ * @return 0 on success, -1 on a table too large or allocation failure.
+ */
+int	topology_complete(t_monitor *m)
+{
+	int	a;
+	int	b;
+
+	if (m->total_philos > COMPLETE_MAX)
+	{
+		printf("error: '-g complete' takes at most %d philosophers\n",
+			COMPLETE_MAX);
+		return (-1);
+	}
+	a = 0;
+	while (a < m->total_philos)
+	{
+		b = a + 1;
+		while (b < m->total_philos)
+			if (add_edge(&m->topology, a, b++) == -1)
+				return (-1);
+		a++;
+	}
+	return (0);
+}
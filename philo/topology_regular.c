@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_regular.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:27:35 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:27:35 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @return true if philosophers 'a' and 'b' share an edge.
+ */
+static bool	has_edge(const t_regular *g, int a, int b)
+{
+	int	i;
+
+	i = 0;
+	while (i < g->k && g->adj[a * g->k + i] != b)
+		i++;
+	return (i < g->k);
+}
+
+/**
+ * Replace neighbour 'from' of philosopher 'a' with 'to'. With 'from' -1,
+ * fill a free slot instead.
+ */
+static void	relink(t_regular *g, int a, int from, int to)
+{
+	int	i;
+
+	i = 0;
+	while (g->adj[a * g->k + i] != from)
+		i++;
+	g->adj[a * g->k + i] = to;
+}
+
+/**
+ * Start from a circulant graph, which is 'k'-regular: philosopher 'i' is
+ * linked to 'i' + 1 up to 'i' + 'k' / 2 on either side, and for an odd
+ * 'k' to the one opposite it, which needs an even table.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	regular_init(t_monitor *m, t_regular *g)
+{
+	const int	n = m->total_philos;
+	int			e;
+	int			d;
+
+	g->edges = n * g->k / 2;
+	g->ends = malloc(2 * (size_t)g->edges * sizeof(int));
+	g->adj = malloc((size_t)n * g->k * sizeof(int));
+	if (g->ends == NULL || g->adj == NULL)
+		return (-1);
+	memset(g->adj, 0xff, (size_t)n * g->k * sizeof(int));
+	e = 0;
+	d = 1;
+	while (e < g->edges)
+	{
+		if (2 * d > g->k)
+			d = n / 2;
+		g->ends[2 * e] = e % n;
+		g->ends[2 * e + 1] = (e % n + d) % n;
+		relink(g, g->ends[2 * e], -1, g->ends[2 * e + 1]);
+		relink(g, g->ends[2 * e + 1], -1, g->ends[2 * e]);
+		e++;
+		if (e % n == 0)
+			d++;
+	}
+	return (0);
+}
+
+/**
+ * Shuffle the graph with 'REGULAR_SWAPS' double edge swaps per edge: a
+ * swap turns edges a-b and c-d into a-d and c-b, which keeps every degree,
+ * and is skipped when that would link a philosopher to itself or twice to
+ * the same neighbour. Enough of them make the graph a uniformly random
+ * 'k'-regular one.
+ *
+ * @param seed Seed of the swaps, '-d'.
+ */
+static void	regular_shuffle(t_regular *g, unsigned int seed)
+{
+	int64_t	swaps;
+	int		e[2];
+	int		v[4];
+
+	prng_seed(&g->rng, seed);
+	swaps = (int64_t)g->edges * REGULAR_SWAPS;
+	while (swaps-- > 0)
+	{
+		e[0] = prng_next(&g->rng) % g->edges;
+		e[1] = prng_next(&g->rng) % g->edges;
+		v[0] = g->ends[2 * e[0]];
+		v[1] = g->ends[2 * e[0] + 1];
+		v[2] = g->ends[2 * e[1]];
+		v[3] = g->ends[2 * e[1] + 1];
+		if (e[0] != e[1] && v[0] != v[3] && v[2] != v[1]
+			&& !has_edge(g, v[0], v[3]) && !has_edge(g, v[2], v[1]))
+		{
+			g->ends[2 * e[0] + 1] = v[3];
+			g->ends[2 * e[1] + 1] = v[1];
+			relink(g, v[0], v[1], v[3]);
+			relink(g, v[1], v[0], v[2]);
+			relink(g, v[2], v[3], v[1]);
+			relink(g, v[3], v[2], v[0]);
+		}
+	}
+}
+
+/**
+ * 'regular:<k>': a random graph where every philosopher shares a fork with
+ * 'k' others, a circulant graph shuffled from the '-d' seed, see
+ * regular_shuffle().
+ *
+ * @return 0 on success, -1 on an impossible 'k' or allocation failure.
+ */
+int	topology_regular(t_monitor *m, int k)
+{
+	t_regular	g;
+	int			i;
+	int			status;
+
+	if (k <= 0 || k >= m->total_philos || (m->total_philos % 2 && k % 2))
+	{
+		printf("error: '-g regular:k' needs 0 < k < philos, k * philos even\n");
+		return (-1);
+	}
+	memset(&g, 0, sizeof(g));
+	g.k = k;
+	status = regular_init(m, &g);
+	if (status == 0)
+		regular_shuffle(&g, m->opts.seed);
+	i = 0;
+	while (status == 0 && i < g.edges)
+	{
+		if (topology_add(&m->topology, g.ends[2 * i], i) == -1
+			|| topology_add(&m->topology, g.ends[2 * i + 1], i) == -1)
+			status = -1;
+		i++;
+	}
+	free(g.ends);
+	free(g.adj);
+	return (status);
+}
@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_rows.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:26:55 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:26:55 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Count the pairs per value of one of their fields, 0 for the philosopher
+ * and 1 for the resource, and turn the counts into running totals: 'ends'
+ * gets one past the last slot of every value, and the number of pairs.
+ *
+ * @param ends Output, 'values' + 1 entries.
+ */
+static void	count_keys(const t_topology *t, int field, int *ends, int values)
+{
+	int	i;
+
+	memset(ends, 0, (values + 1) * sizeof(int));
+	i = 0;
+	while (i < t->pair_count)
+		ends[t->pairs[2 * i++ + field]]++;
+	i = 1;
+	while (i < values)
+	{
+		ends[i] += ends[i - 1];
+		i++;
+	}
+	ends[values] = t->pair_count;
+}
+
+/**
+ * Counting sort of the pairs by resource.
+ *
+ * @return Indices of the pairs by increasing resource, NULL on allocation
+ * failure.
+ */
+static int	*by_resource(const t_topology *t)
+{
+	int	*ends;
+	int	*order;
+	int	i;
+
+	ends = malloc((t->resources + 1) * sizeof(int));
+	order = malloc((t->pair_count + 1) * sizeof(int));
+	if (ends == NULL || order == NULL)
+	{
+		free(ends);
+		free(order);
+		return (NULL);
+	}
+	count_keys(t, 1, ends, t->resources);
+	i = 0;
+	while (i < t->pair_count)
+	{
+		order[--ends[t->pairs[2 * i + 1]]] = i;
+		i++;
+	}
+	free(ends);
+	return (order);
+}
+
+/**
+ * Drop a resource named twice for the same philosopher, which a file may
+ * do. Rows are sorted, so repeats are next to each other.
+ */
+static void	rows_unique(t_topology *t, int philos)
+{
+	int	row;
+	int	from;
+	int	to;
+
+	to = 0;
+	row = 0;
+	while (row < philos)
+	{
+		from = t->offsets[row];
+		t->offsets[row++] = to;
+		while (from < t->offsets[row])
+		{
+			if (to == t->offsets[row - 1] || t->needs[to - 1] != t->needs[from])
+				t->needs[to++] = t->needs[from];
+			from++;
+		}
+	}
+	t->offsets[philos] = to;
+}
+
+/**
+ * Lay the pairs out as one row per philosopher, highest resource first,
+ * with two counting sorts: by resource, then by philosopher filling every
+ * row from its end. That is linear in the pairs and the table, which
+ * matters for '-g complete'.
+ *
+ * @param m Monitor whose topology has its pairs listed.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int	topology_rows(t_monitor *m)
+{
+	t_topology *const	t = &m->topology;
+	int					*order;
+	int					pair;
+	int					i;
+
+	order = by_resource(t);
+	t->offsets = malloc((m->total_philos + 1) * sizeof(int));
+	t->needs = malloc((t->pair_count + 1) * sizeof(int));
+	if (order == NULL || t->offsets == NULL || t->needs == NULL)
+	{
+		free(order);
+		return (-1);
+	}
+	count_keys(t, 0, t->offsets, m->total_philos);
+	i = 0;
+	while (i < t->pair_count)
+	{
+		pair = order[i++];
+		t->needs[--t->offsets[t->pairs[2 * pair]]] = t->pairs[2 * pair + 1];
+	}
+	free(order);
+	rows_unique(t, m->total_philos);
+	return (0);
+}
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:02:22 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 07:37:15 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Write the header of the trace, then the rows of the topology, padded so
+ * the records that follow stay 8-byte aligned in the mapped file.
+ *
+ * @return 0 on success, -1 if the file can't be written.
+ */
+static int	trace_head(t_monitor *m, int fd)
+{
+	const t_topology *const	t = &m->topology;
+	const ssize_t			rows = (m->total_philos + 1) * sizeof(int);
+	const ssize_t			needs = t->offsets[m->total_philos] * sizeof(int);
+	const int64_t			pad = 0;
+	t_trace_header			h;
+
+	memset(&h, 0, sizeof(h));
+	h.magic = TRACE_MAGIC;
+	h.version = TRACE_VERSION;
+	h.philos = m->total_philos;
+	h.must_eat = m->rules.must_eat;
+	h.time_to_die = m->rules.time_to_die;
+	h.time_to_eat = m->rules.time_to_eat;
+	h.time_to_sleep = m->rules.time_to_sleep;
+	h.record_size = sizeof(t_event);
+	h.resources = t->resources;
+	h.needs = t->offsets[m->total_philos];
+	if (write(fd, &h, sizeof(h)) != sizeof(h)
+		|| write(fd, t->offsets, rows) != rows
+		|| write(fd, t->needs, needs) != needs
+		|| write(fd, &pad, (rows + needs) % 8) != (rows + needs) % 8)
+		return (-1);
+	return (0);
+}
+
+/**
+ * Write the rules every philosopher runs with, see 't_trace_rules', so
+ * philo_analyze checks each one against its own.
+ *
+ * @return 0 on success, -1 if the file can't be written.
+ */
+static int	trace_rules(t_monitor *m, int fd)
+{
+	t_trace_rules	r;
+	t_philo			*p;
+	int				i;
+
+	memset(&r, 0, sizeof(r));
+	i = 0;
+	while (i < m->total_philos)
+	{
+		p = &m->philos[i++];
+		r.time_to_die = p->rules.time_to_die;
+		r.shortest_meal = p->eat.low;
+		r.must_eat = p->rules.must_eat;
+		if (write(fd, &r, sizeof(r)) != sizeof(r))
+			return (-1);
+	}
+	return (0);
+}
+
+/**
+ * '-t <file>': create the trace file and write its head, see trace_head()
+ * and trace_rules(), then switch the log to binary so the writer thread
+ * copies raw records into it instead of formatting text. Read back with
+ * philo_analyze.
+ *
+ * @param m Monitor with the rules set.
+ * @return 0 on success or without '-t', -1 if the file can't be written.
+ */
+int	trace_open(t_monitor *m)
+{
+	int	fd;
+
+	if (m->opts.trace_file == NULL)
+		return (0);
+	fd = open(m->opts.trace_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1 || trace_head(m, fd) == -1 || trace_rules(m, fd) == -1)
+	{
+		printf("error: cannot write %s\n", m->opts.trace_file);
+		if (fd != -1)
+			close(fd);
+		return (-1);
+	}
+	m->log.fd = fd;
+	m->log.binary = true;
+	return (0);
+}
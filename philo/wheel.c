@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   wheel.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:08:19 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:08:19 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Put timer 'id' in the slot of the lowest level whose span still covers
+ * it: level L holds timers that share every digit above L with 'now', so
+ * they come due before that level wraps around.
+ *
+ * @param w Wheel to link into.
+ * @param id Timer whose 'tick' is set.
+ */
+static void	wheel_link(t_wheel *w, int id)
+{
+	int64_t	tick;
+	int		level;
+	int		slot;
+
+	tick = w->timers[id].tick;
+	level = 0;
+	while (level < WHEEL_LEVELS - 1
+		&& (tick >> (WHEEL_BITS * (level + 1)))
+		!= (w->now >> (WHEEL_BITS * (level + 1))))
+		level++;
+	slot = level * WHEEL_SIZE + ((tick >> (WHEEL_BITS * level)) & WHEEL_MASK);
+	w->timers[id].next = w->slots[slot];
+	w->slots[slot] = id;
+}
+
+/**
+ * Arm timer 'id', which must not be pending, to fire at 'when'. Times
+ * beyond the top level's reach are clamped, so such a timer fires early
+ * and the owner has to re-arm it.
+ *
+ * @param w Wheel to insert into.
+ * @param id Timer to arm.
+ * @param when Absolute time in microseconds, rounded up to a tick.
+ */
+void	wheel_insert(t_wheel *w, int id, int64_t when)
+{
+	int64_t	tick;
+	int64_t	limit;
+
+	tick = (when + WHEEL_TICK - 1) / WHEEL_TICK;
+	if (tick <= w->now)
+		tick = w->now + 1;
+	limit = ((w->now >> WHEEL_TOP_SHIFT) + WHEEL_MASK) << WHEEL_TOP_SHIFT;
+	if (tick > limit)
+		tick = limit;
+	w->timers[id].tick = tick;
+	wheel_link(w, id);
+}
+
+/**
+ * Move the timers of the current slot at 'level' down the wheel, once all
+ * the levels below it have wrapped around.
+ */
+static void	wheel_cascade(t_wheel *w, int level)
+{
+	int	slot;
+	int	id;
+	int	next;
+
+	slot = level * WHEEL_SIZE + ((w->now >> (WHEEL_BITS * level)) & WHEEL_MASK);
+	id = w->slots[slot];
+	w->slots[slot] = -1;
+	while (id != -1)
+	{
+		next = w->timers[id].next;
+		wheel_link(w, id);
+		id = next;
+	}
+}
+
+/**
+ * Process every tick up to and including 'tick': cascade the upper levels
+ * that wrapped, highest first, then fire the timers due on the tick. The
+ * callback may re-arm other timers, but not the wheel's own lock holder.
+ *
+ * @param w Wheel to advance.
+ * @param tick Current tick, in units of 'WHEEL_TICK'.
+ * @param fire Called with 'm' and the id of each expired timer.
+ * @param m Passed through to 'fire'.
+ */
+void	wheel_advance(t_wheel *w, int64_t tick,
+	void (*fire)(t_monitor *, int), t_monitor *m)
+{
+	int	level;
+	int	id;
+	int	next;
+
+	while (w->now < tick)
+	{
+		w->now++;
+		level = 1;
+		while (level < WHEEL_LEVELS
+			&& (w->now & (((int64_t)1 << (WHEEL_BITS * level)) - 1)) == 0)
+			level++;
+		while (--level > 0)
+			wheel_cascade(w, level);
+		id = w->slots[w->now & WHEEL_MASK];
+		w->slots[w->now & WHEEL_MASK] = -1;
+		while (id != -1)
+		{
+			next = w->timers[id].next;
+			fire(m, id);
+			id = next;
+		}
+	}
+}
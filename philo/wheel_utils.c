@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   wheel_utils.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tpirinen <tpirinen@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:19:31 by tpirinen          #+#    #+#             */
+/*   Updated: 2026/10/17 04:19:31 by tpirinen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Set up an empty wheel for timers 0 to 'count' - 1.
+ *
+ * @param w Wheel to initialize.
+ * @param count Number of timers.
+ * @param now Current tick, in units of 'WHEEL_TICK'.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int	wheel_init(t_wheel *w, int count, int64_t now)
+{
+	int	i;
+
+	w->now = now;
+	i = 0;
+	while (i < WHEEL_LEVELS * WHEEL_SIZE)
+		w->slots[i++] = -1;
+	w->timers = malloc(count * sizeof(t_timer));
+	if (w->timers == NULL)
+		return (-1);
+	return (0);
+}
+
+/**
+ * The next tick worth waking up for: the first non-empty slot of the lowest
+ * level, or the end of that level's span, where the upper levels cascade.
+ * At most 'WHEEL_SIZE' slots are looked at.
+ *
+ * @param w Wheel to look into.
+ * @return Tick in units of 'WHEEL_TICK', always after 'w->now'.
+ */
+int64_t	wheel_next(t_wheel *w)
+{
+	int64_t	tick;
+	int64_t	end;
+
+	tick = w->now + 1;
+	end = (w->now | WHEEL_MASK) + 1;
+	while (tick < end && w->slots[tick & WHEEL_MASK] == -1)
+		tick++;
+	return (tick);
+}